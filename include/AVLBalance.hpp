@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdint>
+#include <utility>
+
+namespace adsc {
+
+// AVL balancing steps shared by the pointer based AVLTree and the array based StaticAVLTree.
+// A tree passes a Links adapter for its child link type (unique_ptr, array index, ...):
+//   left(link) / right(link)  the child links of the node behind a non-null link
+//   balance(link)             height of the left minus height of the right subtree
+//   update(link)              recomputes the height (and aggregate) from the children
+// Links are moved, never copied, so owning pointers work as well as plain indices.
+namespace avl {
+
+template <typename Links, typename Link>
+constexpr void rotateLeft(const Links& links, Link& node) {
+    auto pivot = std::move(links.right(node));
+
+    links.right(node) = std::move(links.left(pivot));
+
+    links.update(node);
+    links.left(pivot) = std::move(node);
+    links.update(pivot);
+
+    node = std::move(pivot);
+}
+
+template <typename Links, typename Link>
+constexpr void rotateRight(const Links& links, Link& node) {
+    auto pivot = std::move(links.left(node));
+
+    links.left(node) = std::move(links.right(pivot));
+
+    links.update(node);
+    links.right(pivot) = std::move(node);
+    links.update(pivot);
+
+    node = std::move(pivot);
+}
+
+// Restores the AVL invariant at a non-null node whose children are balanced
+template <typename Links, typename Link>
+constexpr void rebalance(const Links& links, Link& node) {
+    int32_t balance = links.balance(node);
+
+    // Left heavy
+    if (balance > 1) {
+        if (links.balance(links.left(node)) < 0) {
+            // Left-Right case
+            rotateLeft(links, links.left(node));
+        }
+        rotateRight(links, node);
+    }
+    // Right heavy
+    else if (balance < -1) {
+        if (links.balance(links.right(node)) > 0) {
+            // Right-Left case
+            rotateRight(links, links.right(node));
+        }
+        rotateLeft(links, node);
+    }
+}
+
+} // namespace avl
+
+} // namespace adsc
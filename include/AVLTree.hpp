@@ -1,71 +1,312 @@
 #pragma once
 
+#include "AVLBalance.hpp"
 #include "BinaryTree.hpp"
 
+#include <array>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
 namespace adsc {
 
-template <typename T, typename Comparator = std::less<T>>
-class AVLTree : public BinarySortingTree<T, Comparator> {
+// Where a hinted insertion starts looking for its position
+enum class InsertHint { None, NearMin, NearMax };
+
+template <typename T, typename Comparator = std::less<T>, typename Augmentation = NoAugmentation<T>,
+          typename Layout = DefaultNodeLayout>
+class AVLTree : public SortedTree<AVLTree<T, Comparator, Augmentation, Layout>, T, Comparator, Augmentation, Layout> {
 public:
     AVLTree(Comparator comparator = Comparator());
+    // Copies every node as it is, shape and tombstones included, O(n)
+    AVLTree(const AVLTree& other);
+    // Take the nodes over in O(1) and leave other empty
+    AVLTree(AVLTree&& other) noexcept(std::is_nothrow_copy_constructible_v<Comparator>);
+    AVLTree& operator=(AVLTree&& other) noexcept(std::is_nothrow_copy_assignable_v<Comparator>);
     ~AVLTree() = default;
 
-    void insert(T data) override;
-    void remove(const T& data) override;
-    T removeMin() override;
-    T removeMax() override;
+    void insert(T data);
+    void remove(const T& data);
+    T removeMin();
+    T removeMax();
+
+    // Bulk variants, O(log n) whatever the count. remove and removeMin/removeMax
+    // take at most the stored copies and report how many were actually removed
+    void insert(T data, uint64_t count);
+    uint64_t remove(const T& data, uint64_t count);
+    std::pair<T, uint64_t> removeMin(uint64_t count);
+    std::pair<T, uint64_t> removeMax(uint64_t count);
+
+    // Scans the left (NearMin) or right (NearMax) spine bottom-up before descending,
+    // a key d ranks away from the extreme costs O(log d) comparisons instead of O(log n)
+    void insert(InsertHint hint, T data);
+
+    // In finger mode insert() reuses the spine the previous insertion landed on,
+    // sorted and nearly sorted input then costs amortized O(1) comparisons
+    void setFingerSearch(bool enabled);
+    bool isFingerSearch() const { return m_fingerSearch; };
+
+    // In lazy mode remove() leaves a tombstone (count 0) behind instead of unlinking
+    // the node, the tree is rebuilt once tombstones exceed the given share of nodes
+    void setLazyRemoval(bool enabled, double maxTombstoneRatio = 0.25);
+    bool isLazyRemoval() const { return m_lazyRemoval; };
+    size_t tombstonesCount() const { return m_tombstonesCount; };
+
+    // Drops all tombstones and rebuilds a perfectly balanced tree in O(n)
+    void compact();
+
+    // Aggregate of the whole tree and of the keys in [lo, hi], O(log n)
+    auto aggregate() const;
+    auto rangeAggregate(const T& lo, const T& hi) const;
 
 private:
-    using BinarySortingTree<T, Comparator>::m_root;
+    using Base = SortedTree<AVLTree<T, Comparator, Augmentation, Layout>, T, Comparator, Augmentation, Layout>;
+    using Base::m_root;
+    friend Base;
+
+    // Hook of clear and drain
+    void onClear();
     
-    using TreeNodePtr = std::unique_ptr<BinaryTreeNode<T>>;
+    using TreeNodePtr = std::unique_ptr<BinaryTreeNode<T, Augmentation, Layout>>;
 
     // Helper for insert
-    void recursive_insert(TreeNodePtr& node, T data);
+    void recursive_insert(TreeNodePtr& node, T data, uint64_t count);
+
+    // Helpers for hinted insert, descend a spine without comparing keys
+    bool spineInsert(InsertHint hint, T& data);
+    void recursive_spine_insert(TreeNodePtr& node, size_t steps, bool rightSpine, T data);
+    InsertHint landedOn(const T& data) const;
 
     // Helpers for remove
-    void recursive_remove(TreeNodePtr& node, const T& data);
+    uint64_t recursive_remove(TreeNodePtr& node, const T& data, uint64_t count);
     TreeNodePtr extractMin(TreeNodePtr& node); 
 
     // Helper for removeMin
-    T recursive_remove_min(TreeNodePtr& node);
+    T recursive_remove_min(TreeNodePtr& node, uint64_t count);
 
     // Helper for removeMax
-    T recursive_remove_max(TreeNodePtr& node);
+    T recursive_remove_max(TreeNodePtr& node, uint64_t count);
 
     void rebalance(TreeNodePtr& node);
-    
-    void rotateLeft(TreeNodePtr& node);
-    void rotateRight(TreeNodePtr& node);
 
+    // Child links for the shared balancing steps
+    struct NodeLinks {
+        TreeNodePtr& left(TreeNodePtr& node) const { return node->getLeft(); }
+        TreeNodePtr& right(TreeNodePtr& node) const { return node->getRight(); }
+        int32_t balance(const TreeNodePtr& node) const { return node->getNodeBalance(); }
+        void update(TreeNodePtr& node) const { node->updateHeight(); }
+    };
+
+    // Helpers for lazy removal, cached extremes never point at a tombstone
+    void settleMin();
+    void settleMax();
+    TreeNodePtr extractMax(TreeNodePtr& node);
+
+    // Helpers for rangeAggregate, fold the keys >= lo / <= hi of a subtree
+    auto aggregateFrom(const BinaryTreeNode<T, Augmentation, Layout>* node, const T& lo) const;
+    auto aggregateTo(const BinaryTreeNode<T, Augmentation, Layout>* node, const T& hi) const;
+
+    // Helper for the copy constructor
+    TreeNodePtr recursive_copy(const TreeNodePtr& node, const AVLTree& other);
+
+    // Helper for the move constructor and assignment
+    void takeNodes(AVLTree& other);
+
+    // Helpers for compact
+    void flatten(TreeNodePtr node, std::vector<TreeNodePtr>& nodes);
+    TreeNodePtr buildBalanced(std::vector<TreeNodePtr>& nodes, size_t begin, size_t end);
+
+    // AVL trees of any feasible size are shallower than this
+    static constexpr size_t kMaxSpine = 64;
+
+    bool m_fingerSearch{false};
+    InsertHint m_finger{InsertHint::None};
+
+    bool m_lazyRemoval{false};
+    double m_maxTombstoneRatio{0.25};
+    size_t m_tombstonesCount{0};
 };
 
-template <typename T, typename Comparator>
-AVLTree<T, Comparator>::AVLTree(Comparator comparator)
-: BinarySortingTree<T, Comparator>(comparator)
+template <typename T, typename Comparator, typename Augmentation, typename Layout>
+AVLTree<T, Comparator, Augmentation, Layout>::AVLTree(Comparator comparator)
+: Base(comparator)
 {}  
 
-template <typename T, typename Comparator>
-void AVLTree<T, Comparator>::insert(T data) {
-    this->m_elementsCount++;
-    recursive_insert(m_root, std::move(data));
+template <typename T, typename Comparator, typename Augmentation, typename Layout>
+AVLTree<T, Comparator, Augmentation, Layout>::AVLTree(const AVLTree& other)
+: Base(other.m_comparator)
+, m_fingerSearch(other.m_fingerSearch)
+, m_finger(other.m_finger)
+, m_lazyRemoval(other.m_lazyRemoval)
+, m_maxTombstoneRatio(other.m_maxTombstoneRatio)
+, m_tombstonesCount(other.m_tombstonesCount)
+{
+    m_root = recursive_copy(other.m_root, other);
+    this->m_nodesCount = other.m_nodesCount;
+    this->m_elementsCount = other.m_elementsCount;
+}
+
+template <typename T, typename Comparator, typename Augmentation, typename Layout>
+AVLTree<T, Comparator, Augmentation, Layout>::AVLTree(AVLTree&& other) noexcept(std::is_nothrow_copy_constructible_v<Comparator>)
+: Base(other.m_comparator)
+, m_fingerSearch(other.m_fingerSearch)
+, m_finger(other.m_finger)
+, m_lazyRemoval(other.m_lazyRemoval)
+, m_maxTombstoneRatio(other.m_maxTombstoneRatio)
+, m_tombstonesCount(other.m_tombstonesCount)
+{
+    takeNodes(other);
+}
+
+template <typename T, typename Comparator, typename Augmentation, typename Layout>
+AVLTree<T, Comparator, Augmentation, Layout>&
+AVLTree<T, Comparator, Augmentation, Layout>::operator=(AVLTree&& other) noexcept(std::is_nothrow_copy_assignable_v<Comparator>) {
+    if (this != &other) {
+        this->m_comparator = other.m_comparator;
+        m_fingerSearch = other.m_fingerSearch;
+        m_finger = other.m_finger;
+        m_lazyRemoval = other.m_lazyRemoval;
+        m_maxTombstoneRatio = other.m_maxTombstoneRatio;
+        m_tombstonesCount = other.m_tombstonesCount;
+        takeNodes(other);
+    }
+    return *this;
+}
+
+template <typename T, typename Comparator, typename Augmentation, typename Layout>
+void AVLTree<T, Comparator, Augmentation, Layout>::takeNodes(AVLTree& other) {
+    // The nodes move as they are, the cached extremes stay valid. Detaching resets
+    // the counters and tombstones of other, the previous nodes of this tree are freed
+    this->m_minNode = other.m_minNode;
+    this->m_maxNode = other.m_maxNode;
+    this->m_nodesCount = other.m_nodesCount;
+    this->m_elementsCount = other.m_elementsCount;
+    m_root = other.detachNodes();
+}
+
+template <typename T, typename Comparator, typename Augmentation, typename Layout>
+typename AVLTree<T, Comparator, Augmentation, Layout>::TreeNodePtr
+AVLTree<T, Comparator, Augmentation, Layout>::recursive_copy(const TreeNodePtr& node, const AVLTree& other) {
+    if (!node) {
+        return nullptr;
+    }
+
+    auto copy = std::make_unique<BinaryTreeNode<T, Augmentation, Layout>>(node->getData(), node->getCount());
+    copy->getLeft() = recursive_copy(node->getLeft(), other);
+    copy->getRight() = recursive_copy(node->getRight(), other);
+    copy->updateHeight();
+
+    // The cached extremes skip tombstones, so they are not always the outermost nodes
+    if (node.get() == other.m_minNode) this->m_minNode = copy.get();
+    if (node.get() == other.m_maxNode) this->m_maxNode = copy.get();
+    return copy;
+}
+
+template <typename T, typename Comparator, typename Augmentation, typename Layout>
+void AVLTree<T, Comparator, Augmentation, Layout>::insert(T data) {
+    if (m_fingerSearch) {
+        insert(m_finger, std::move(data));
+        return;
+    }
+    insert(std::move(data), 1);
+}
+
+template <typename T, typename Comparator, typename Augmentation, typename Layout>
+void AVLTree<T, Comparator, Augmentation, Layout>::insert(T data, uint64_t count) {
+    if (count == 0) {
+        return;
+    }
+    this->addElements(count);
+    recursive_insert(m_root, std::move(data), count);
+}
+
+template <typename T, typename Comparator, typename Augmentation, typename Layout>
+void AVLTree<T, Comparator, Augmentation, Layout>::insert(InsertHint hint, T data) {
+    this->addElements(1);
+    if (hint != InsertHint::None && spineInsert(hint, data)) {
+        m_finger = hint;
+        return;
+    }
+
+    if (m_fingerSearch) {
+        m_finger = landedOn(data);
+    }
+    recursive_insert(m_root, std::move(data), 1);
+}
+
+template <typename T, typename Comparator, typename Augmentation, typename Layout>
+void AVLTree<T, Comparator, Augmentation, Layout>::setFingerSearch(bool enabled) {
+    m_fingerSearch = enabled;
+    m_finger = InsertHint::None;
+}
+
+template <typename T, typename Comparator, typename Augmentation, typename Layout>
+InsertHint AVLTree<T, Comparator, Augmentation, Layout>::landedOn(const T& data) const {
+    // A key past either extreme is the next one to extend that spine
+    if (!this->m_maxNode || !this->m_comparator(data, this->m_maxNode->getData())) {
+        return InsertHint::NearMax;
+    }
+    if (!this->m_comparator(this->m_minNode->getData(), data)) {
+        return InsertHint::NearMin;
+    }
+    return InsertHint::None;
+}
+
+template <typename T, typename Comparator, typename Augmentation, typename Layout>
+bool AVLTree<T, Comparator, Augmentation, Layout>::spineInsert(InsertHint hint, T& data) {
+    bool rightSpine = hint == InsertHint::NearMax;
+    std::array<const BinaryTreeNode<T, Augmentation, Layout>*, kMaxSpine> spine;
+    size_t length = 0;
+    for (const BinaryTreeNode<T, Augmentation, Layout>* node = m_root.get(); node && length < kMaxSpine;
+         node = rightSpine ? node->getRight().get() : node->getLeft().get()) {
+        spine[length++] = node;
+    }
+
+    // The deepest spine node not beyond the key roots the subtree the key belongs to
+    for (size_t i = length; i-- > 0;) {
+        bool inside = rightSpine ? !this->m_comparator(data, spine[i]->getData())
+                                 : !this->m_comparator(spine[i]->getData(), data);
+        if (inside) {
+            recursive_spine_insert(m_root, i, rightSpine, std::move(data));
+            return true;
+        }
+    }
+    // Beyond the root, the hint was wrong
+    return false;
+}
+
+template <typename T, typename Comparator, typename Augmentation, typename Layout>
+void AVLTree<T, Comparator, Augmentation, Layout>::recursive_spine_insert(TreeNodePtr& node, size_t steps, bool rightSpine, T data) {
+    if (steps == 0) {
+        recursive_insert(node, std::move(data), 1);
+        return;
+    }
+
+    recursive_spine_insert(rightSpine ? node->getRight() : node->getLeft(), steps - 1, rightSpine, std::move(data));
+    node->updateHeight();
+    rebalance(node);
 }
 
-template <typename T, typename Comparator>
-void AVLTree<T, Comparator>::recursive_insert(TreeNodePtr& node, T data) {
+template <typename T, typename Comparator, typename Augmentation, typename Layout>
+void AVLTree<T, Comparator, Augmentation, Layout>::recursive_insert(TreeNodePtr& node, T data, uint64_t count) {
     if (!node) {
         this->m_nodesCount++;
-        node = std::make_unique<BinaryTreeNode<T>>(std::move(data));
+        node = std::make_unique<BinaryTreeNode<T, Augmentation, Layout>>(std::move(data), count);
+        this->trackInserted(node.get());
         return;
     }
 
     if (data == node->getData()) {
-        node->incrementCount();
+        if (node->getCount() == 0) {
+            // Revive a tombstone without allocating
+            m_tombstonesCount--;
+        }
+        node->incrementCount(count);
     } else {
         if (this->m_comparator(data, node->getData())) {
-            recursive_insert(node->getLeft(), std::move(data));
+            recursive_insert(node->getLeft(), std::move(data), count);
         } else {
-            recursive_insert(node->getRight(), std::move(data));
+            recursive_insert(node->getRight(), std::move(data), count);
         }
     }
 
@@ -74,41 +315,81 @@ void AVLTree<T, Comparator>::recursive_insert(TreeNodePtr& node, T data) {
     return;
 }
 
-template <typename T, typename Comparator>
-void AVLTree<T, Comparator>::remove(const T& data) {
-    recursive_remove(m_root, data);
+template <typename T, typename Comparator, typename Augmentation, typename Layout>
+void AVLTree<T, Comparator, Augmentation, Layout>::remove(const T& data) {
+    remove(data, 1);
+}
+
+template <typename T, typename Comparator, typename Augmentation, typename Layout>
+uint64_t AVLTree<T, Comparator, Augmentation, Layout>::remove(const T& data, uint64_t count) {
+    if (this->empty()) {
+        return 0;
+    }
+
+    // Only a removed node equivalent to an extreme can invalidate the cache
+    bool touchesMin = this->isEquivalent(data, this->m_minNode->getData());
+    bool touchesMax = this->isEquivalent(data, this->m_maxNode->getData());
+    size_t nodesBefore = this->m_nodesCount;
+
+    uint64_t removed = recursive_remove(m_root, data, count);
+
+    if (this->m_nodesCount != nodesBefore) {
+        if (touchesMin) settleMin();
+        if (touchesMax) settleMax();
+    }
+
+    if (m_tombstonesCount > m_maxTombstoneRatio * this->m_nodesCount) {
+        compact();
+    }
+    return removed;
 }
 
-template <typename T, typename Comparator>
-void AVLTree<T, Comparator>::recursive_remove(TreeNodePtr& node, const T& data) {
+template <typename T, typename Comparator, typename Augmentation, typename Layout>
+uint64_t AVLTree<T, Comparator, Augmentation, Layout>::recursive_remove(TreeNodePtr& node, const T& data, uint64_t count) {
     if (!node){
         // Record not found
-        return;
+        return 0;
     }
 
+    uint64_t removed = 0;
     if (this->m_comparator(data, node->getData())) {
-        recursive_remove(node->getLeft(), data);
+        removed = recursive_remove(node->getLeft(), data, count);
     } else if (this->m_comparator(node->getData(), data)) {
-        recursive_remove(node->getRight(), data);
+        removed = recursive_remove(node->getRight(), data, count);
     } else {
         // Data found
-        if (node->decrementCount()) {
-            this->m_elementsCount--;
-            return;
+        if (node->getCount() == 0) {
+            // Tombstone, an equivalent live node can only sit on the right
+            removed = recursive_remove(node->getRight(), data, count);
+            node->updateHeight();
+            rebalance(node);
+            return removed;
+        }
+
+        removed = std::min(count, node->getCount());
+        this->m_elementsCount -= removed;
+        if (node->decrementCount(removed)) {
+            node->updateHeight();
+            return removed;
         }
 
-        this->m_elementsCount--;
+        if (m_lazyRemoval && node.get() != this->m_minNode && node.get() != this->m_maxNode) {
+            // Keep the node as a tombstone
+            m_tombstonesCount++;
+            node->updateHeight();
+            return removed;
+        }
         this->m_nodesCount--;
 
         if (!node->getLeft()) {
             // Only right child case
             node = std::move(node->getRight());
-            return;
+            return removed;
         } 
         else if (!node->getRight()) {
             // Only left child case
             node = std::move(node->getLeft());
-            return;
+            return removed;
         } 
         else {
             // Two children case
@@ -123,11 +404,12 @@ void AVLTree<T, Comparator>::recursive_remove(TreeNodePtr& node, const T& data)
         node->updateHeight();
         rebalance(node);
     }
+    return removed;
 }
 
-template <typename T, typename Comparator>
-typename AVLTree<T, Comparator>::TreeNodePtr 
-AVLTree<T, Comparator>::extractMin(TreeNodePtr& node) {
+template <typename T, typename Comparator, typename Augmentation, typename Layout>
+typename AVLTree<T, Comparator, Augmentation, Layout>::TreeNodePtr 
+AVLTree<T, Comparator, Augmentation, Layout>::extractMin(TreeNodePtr& node) {
     if (node->getLeft()) {
         TreeNodePtr minNode = extractMin(node->getLeft());
         node->updateHeight();
@@ -140,118 +422,269 @@ AVLTree<T, Comparator>::extractMin(TreeNodePtr& node) {
     return minNode;
 }
 
-template <typename T, typename Comparator>
-T AVLTree<T, Comparator>::removeMin() {
+template <typename T, typename Comparator, typename Augmentation, typename Layout>
+typename AVLTree<T, Comparator, Augmentation, Layout>::TreeNodePtr
+AVLTree<T, Comparator, Augmentation, Layout>::extractMax(TreeNodePtr& node) {
+    if (node->getRight()) {
+        TreeNodePtr maxNode = extractMax(node->getRight());
+        node->updateHeight();
+        rebalance(node);
+        return maxNode;
+    }
+
+    TreeNodePtr maxNode = std::move(node);
+    node = std::move(maxNode->getLeft());
+    return maxNode;
+}
+
+template <typename T, typename Comparator, typename Augmentation, typename Layout>
+void AVLTree<T, Comparator, Augmentation, Layout>::settleMin() {
+    this->refreshMin();
+    while (this->m_minNode && this->m_minNode->getCount() == 0) {
+        extractMin(m_root);
+        this->m_nodesCount--;
+        m_tombstonesCount--;
+        this->refreshMin();
+    }
+}
+
+template <typename T, typename Comparator, typename Augmentation, typename Layout>
+void AVLTree<T, Comparator, Augmentation, Layout>::settleMax() {
+    this->refreshMax();
+    while (this->m_maxNode && this->m_maxNode->getCount() == 0) {
+        extractMax(m_root);
+        this->m_nodesCount--;
+        m_tombstonesCount--;
+        this->refreshMax();
+    }
+}
+
+template <typename T, typename Comparator, typename Augmentation, typename Layout>
+void AVLTree<T, Comparator, Augmentation, Layout>::onClear() {
+    m_tombstonesCount = 0;
+    m_finger = InsertHint::None;
+}
+
+template <typename T, typename Comparator, typename Augmentation, typename Layout>
+void AVLTree<T, Comparator, Augmentation, Layout>::setLazyRemoval(bool enabled, double maxTombstoneRatio) {
+    m_lazyRemoval = enabled;
+    m_maxTombstoneRatio = maxTombstoneRatio;
+    if (!enabled) {
+        compact();
+    }
+}
+
+template <typename T, typename Comparator, typename Augmentation, typename Layout>
+void AVLTree<T, Comparator, Augmentation, Layout>::compact() {
+    if (m_tombstonesCount == 0) {
+        return;
+    }
+
+    std::vector<TreeNodePtr> nodes;
+    nodes.reserve(this->m_nodesCount - m_tombstonesCount);
+    flatten(std::move(m_root), nodes);
+
+    m_root = buildBalanced(nodes, 0, nodes.size());
+    this->m_nodesCount = nodes.size();
+    m_tombstonesCount = 0;
+}
+
+template <typename T, typename Comparator, typename Augmentation, typename Layout>
+void AVLTree<T, Comparator, Augmentation, Layout>::flatten(TreeNodePtr node, std::vector<TreeNodePtr>& nodes) {
+    if (!node) {
+        return;
+    }
+
+    flatten(std::move(node->getLeft()), nodes);
+    TreeNodePtr right = std::move(node->getRight());
+    if (node->getCount() > 0) {
+        nodes.push_back(std::move(node));
+    }
+    flatten(std::move(right), nodes);
+}
+
+template <typename T, typename Comparator, typename Augmentation, typename Layout>
+typename AVLTree<T, Comparator, Augmentation, Layout>::TreeNodePtr
+AVLTree<T, Comparator, Augmentation, Layout>::buildBalanced(std::vector<TreeNodePtr>& nodes, size_t begin, size_t end) {
+    if (begin == end) {
+        return nullptr;
+    }
+
+    size_t middle = begin + (end - begin) / 2;
+    TreeNodePtr node = std::move(nodes[middle]);
+    node->getLeft() = buildBalanced(nodes, begin, middle);
+    node->getRight() = buildBalanced(nodes, middle + 1, end);
+    node->updateHeight();
+    return node;
+}
+
+template <typename T, typename Comparator, typename Augmentation, typename Layout>
+auto AVLTree<T, Comparator, Augmentation, Layout>::aggregate() const {
+    return m_root ? m_root->getAggregate() : Augmentation::identity();
+}
+
+template <typename T, typename Comparator, typename Augmentation, typename Layout>
+auto AVLTree<T, Comparator, Augmentation, Layout>::rangeAggregate(const T& lo, const T& hi) const {
+    // Descend to the first node inside the range, both bounds split below it
+    const BinaryTreeNode<T, Augmentation, Layout>* node = m_root.get();
+    while (node) {
+        if (this->m_comparator(node->getData(), lo)) {
+            node = node->getRight().get();
+        } else if (this->m_comparator(hi, node->getData())) {
+            node = node->getLeft().get();
+        } else {
+            break;
+        }
+    }
+    if (!node) {
+        return Augmentation::identity();
+    }
+
+    auto result = Augmentation::lift(node->getData(), node->getCount());
+    result = Augmentation::combine(aggregateFrom(node->getLeft().get(), lo), result);
+    return Augmentation::combine(result, aggregateTo(node->getRight().get(), hi));
+}
+
+template <typename T, typename Comparator, typename Augmentation, typename Layout>
+auto AVLTree<T, Comparator, Augmentation, Layout>::aggregateFrom(const BinaryTreeNode<T, Augmentation, Layout>* node, const T& lo) const {
+    auto result = Augmentation::identity();
+    while (node) {
+        if (this->m_comparator(node->getData(), lo)) {
+            node = node->getRight().get();
+            continue;
+        }
+        // The node and its whole right subtree are in range and follow everything found later
+        auto suffix = Augmentation::lift(node->getData(), node->getCount());
+        if (node->getRight()) suffix = Augmentation::combine(suffix, node->getRight()->getAggregate());
+        result = Augmentation::combine(suffix, result);
+        node = node->getLeft().get();
+    }
+    return result;
+}
+
+template <typename T, typename Comparator, typename Augmentation, typename Layout>
+auto AVLTree<T, Comparator, Augmentation, Layout>::aggregateTo(const BinaryTreeNode<T, Augmentation, Layout>* node, const T& hi) const {
+    auto result = Augmentation::identity();
+    while (node) {
+        if (this->m_comparator(hi, node->getData())) {
+            node = node->getLeft().get();
+            continue;
+        }
+        // The node and its whole left subtree are in range and precede everything found later
+        auto prefix = Augmentation::lift(node->getData(), node->getCount());
+        if (node->getLeft()) prefix = Augmentation::combine(node->getLeft()->getAggregate(), prefix);
+        result = Augmentation::combine(result, prefix);
+        node = node->getRight().get();
+    }
+    return result;
+}
+
+template <typename T, typename Comparator, typename Augmentation, typename Layout>
+T AVLTree<T, Comparator, Augmentation, Layout>::removeMin() {
+    return removeMin(1).first;
+}
+
+template <typename T, typename Comparator, typename Augmentation, typename Layout>
+std::pair<T, uint64_t> AVLTree<T, Comparator, Augmentation, Layout>::removeMin(uint64_t count) {
     if (this->empty()) {
         throw std::runtime_error("Tree is empty");
     }
-    this->m_elementsCount--;
-    return std::move(recursive_remove_min(m_root));
+
+    uint64_t removed = std::min(count, this->m_minNode->getCount());
+    this->m_elementsCount -= removed;
+    if (!Augmentation::enabled && this->m_minNode->getCount() > removed) {
+        // Only decrement count, the cached node spares the spine walk
+        // (augmented trees walk down to refresh the ancestors' aggregates)
+        this->m_minNode->decrementCount(removed);
+        return {this->m_minNode->getData(), removed};
+    }
+
+    T outData = recursive_remove_min(m_root, removed);
+    settleMin();
+    if (this->empty()) {
+        this->m_maxNode = nullptr;
+    }
+    return {std::move(outData), removed};
 }
 
-template <typename T, typename Comparator>
-T AVLTree<T, Comparator>::recursive_remove_min(TreeNodePtr& node) {
+template <typename T, typename Comparator, typename Augmentation, typename Layout>
+T AVLTree<T, Comparator, Augmentation, Layout>::recursive_remove_min(TreeNodePtr& node, uint64_t count) {
     // Iterate to find min value
     if (node->getLeft()) {
-        T outData = std::move(recursive_remove_min(node->getLeft()));
+        T outData = recursive_remove_min(node->getLeft(), count);
         node->updateHeight();
         rebalance(node);
-        return std::move(outData);
+        return outData;
     }
 
     T outData = std::move(node->getData());
-    if (node->decrementCount()) {
+    if (node->decrementCount(count)) {
         // Only decrement count
-        return std::move(outData);
+        node->updateHeight();
+        return outData;
     }
     // Replace node with its right child
     this->m_nodesCount--;
     node = std::move(node->getRight());
-    return std::move(outData);
+    return outData;
+}
+
+template <typename T, typename Comparator, typename Augmentation, typename Layout>
+T AVLTree<T, Comparator, Augmentation, Layout>::removeMax() {
+    return removeMax(1).first;
 }
 
-template <typename T, typename Comparator>
-T AVLTree<T, Comparator>::removeMax() {
+template <typename T, typename Comparator, typename Augmentation, typename Layout>
+std::pair<T, uint64_t> AVLTree<T, Comparator, Augmentation, Layout>::removeMax(uint64_t count) {
     if (this->empty()) {
         throw std::runtime_error("Tree is empty");
     }
-    this->m_elementsCount--;
-    return std::move(recursive_remove_max(m_root));
+
+    uint64_t removed = std::min(count, this->m_maxNode->getCount());
+    this->m_elementsCount -= removed;
+    if (!Augmentation::enabled && this->m_maxNode->getCount() > removed) {
+        // Only decrement count, the cached node spares the spine walk
+        // (augmented trees walk down to refresh the ancestors' aggregates)
+        this->m_maxNode->decrementCount(removed);
+        return {this->m_maxNode->getData(), removed};
+    }
+
+    T outData = recursive_remove_max(m_root, removed);
+    settleMax();
+    if (this->empty()) {
+        this->m_minNode = nullptr;
+    }
+    return {std::move(outData), removed};
 }
 
-template <typename T, typename Comparator>
-T AVLTree<T, Comparator>::recursive_remove_max(TreeNodePtr& node) {
+template <typename T, typename Comparator, typename Augmentation, typename Layout>
+T AVLTree<T, Comparator, Augmentation, Layout>::recursive_remove_max(TreeNodePtr& node, uint64_t count) {
     // Iterate to find max value
     if (node->getRight()) {
-        T outData = std::move(recursive_remove_max(node->getRight()));
+        T outData = recursive_remove_max(node->getRight(), count);
         node->updateHeight();
         rebalance(node);
-        return std::move(outData);
+        return outData;
     }
 
     T outData = std::move(node->getData());
-    if (node->decrementCount()) {
+    if (node->decrementCount(count)) {
         // Only decrement count
-        return std::move(outData);
+        node->updateHeight();
+        return outData;
     }
     // Replace node with its left child
     this->m_nodesCount--;
     node = std::move(node->getLeft());  
-    return std::move(outData);
+    return outData;
 }
 
-template <typename T, typename Comparator>
-void AVLTree<T, Comparator>::rebalance(TreeNodePtr& node) {
+template <typename T, typename Comparator, typename Augmentation, typename Layout>
+void AVLTree<T, Comparator, Augmentation, Layout>::rebalance(TreeNodePtr& node) {
     if (!node) {
          return;
     }
-
-    int32_t balance = node->getNodeBalance();
-
-    // Left heavy
-    if (balance > 1) {
-        if (node->getLeft()->getNodeBalance() < 0) {
-            // Left-Right case
-            rotateLeft(node->getLeft());
-        }
-        rotateRight(node);
-    }
-    // Right heavy
-    else if (balance < -1) {
-        if (node->getRight()->getNodeBalance() > 0) {
-            // Right-Left case
-            rotateRight(node->getRight());
-        }
-        rotateLeft(node);
-    }
-}
-
-template <typename T, typename Comparator>
-void AVLTree<T, Comparator>::rotateLeft(TreeNodePtr& node) {
-
-    auto pivot = std::move(node->getRight());
-
-    node->getRight() = std::move(pivot->getLeft());
-
-    node->updateHeight();
-    pivot->getLeft() = std::move(node);
-    pivot->updateHeight();
-
-    node = std::move(pivot);
-}
-
-template <typename T, typename Comparator>
-void AVLTree<T, Comparator>::rotateRight(TreeNodePtr& node) {
-
-    auto pivot = std::move(node->getLeft());
-    
-    node->getLeft() = std::move(pivot->getRight());
-    
-    node->updateHeight();
-    pivot->getRight() = std::move(node);
-    pivot->updateHeight();
-    
-    node = std::move(pivot);
+    avl::rebalance(NodeLinks(), node);
 }
 
 } // namespace adsc
\ No newline at end of file
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace adsc {
+
+// Augmentation policies fold a monoid over every subtree of a tree:
+//   value_type                   aggregated value stored in each node
+//   identity()                   neutral element
+//   lift(data, count)            value of one node, identity() for count == 0
+//   combine(left, right)         associative, called in key order
+// Nodes recompute it in updateHeight, so rotations and extraction keep it valid.
+
+template <typename T>
+struct NoAugmentation {
+    static constexpr bool enabled = false;
+};
+
+// Default accumulator of SumAugmentation: 64-bit for integers, at least double for
+// floating point, T itself for anything else
+template <typename T, typename = void>
+struct SumAccumulator {
+    using type = T;
+};
+
+template <typename T>
+struct SumAccumulator<T, std::enable_if_t<std::is_integral_v<T>>> {
+    using type = std::conditional_t<std::is_signed_v<T>, int64_t, uint64_t>;
+};
+
+template <typename T>
+struct SumAccumulator<T, std::enable_if_t<std::is_floating_point_v<T>>> {
+    using type = std::conditional_t<(sizeof(T) > sizeof(double)), T, double>;
+};
+
+// Sums are not checked, a total beyond the range of Accumulator wraps (unsigned) or is
+// undefined (signed). The 64-bit default covers 2^32 copies of any 32-bit key
+template <typename T, typename Accumulator = typename SumAccumulator<T>::type>
+struct SumAugmentation {
+    static constexpr bool enabled = true;
+    using value_type = Accumulator;
+
+    static value_type identity() { return value_type{}; }
+    static value_type lift(const T& data, uint64_t count) {
+        return static_cast<value_type>(data) * static_cast<value_type>(count);
+    }
+    static value_type combine(const value_type& left, const value_type& right) { return left + right; }
+};
+
+template <typename T>
+struct MinAugmentation {
+    static constexpr bool enabled = true;
+    using value_type = T;
+
+    static value_type identity() { return std::numeric_limits<T>::max(); }
+    static value_type lift(const T& data, uint64_t count) { return count > 0 ? data : identity(); }
+    static value_type combine(const value_type& left, const value_type& right) { return std::min(left, right); }
+};
+
+template <typename T>
+struct MaxAugmentation {
+    static constexpr bool enabled = true;
+    using value_type = T;
+
+    static value_type identity() { return std::numeric_limits<T>::lowest(); }
+    static value_type lift(const T& data, uint64_t count) { return count > 0 ? data : identity(); }
+    static value_type combine(const value_type& left, const value_type& right) { return std::max(left, right); }
+};
+
+// Storage for the subtree aggregate, empty for disabled policies
+template <typename Augmentation, bool = Augmentation::enabled>
+class AugmentedValue {};
+
+template <typename Augmentation>
+class AugmentedValue<Augmentation, true> {
+public:
+    const typename Augmentation::value_type& getAggregate() const { return m_aggregate; }
+
+protected:
+    typename Augmentation::value_type m_aggregate{Augmentation::identity()};
+};
+
+} // namespace adsc
@@ -1,17 +1,17 @@
 #pragma once
 
-#include "BinaryTreeNode.hpp"
+#include <cstddef>
 #include <functional>
-#include <memory>
+#include <utility>
 
 namespace adsc {
 
+// Runtime-polymorphic interface of the sorted containers. The containers themselves
+// are statically dispatched (see SortedTree), this interface is opt-in through
+// TreeAdapter for code that has to pick an implementation at runtime.
 template <typename T, typename Comparator = std::less<T>>
 class BinarySortingTree {
 public:
-
-    explicit BinarySortingTree(Comparator comp = Comparator());
-
     virtual ~BinarySortingTree() = default;
 
     virtual void insert(T data) = 0;
@@ -19,53 +19,39 @@ public:
     virtual T removeMin() = 0;
     virtual T removeMax() = 0;
 
-    size_t nodesCount() const {return m_nodesCount;};
-    size_t elementsCount() const {return m_elementsCount;};
-
-
-    virtual bool search(const T& data) const {
-        return searchRecursive(m_root, data);
-    }
-
-    bool empty() const;
+    virtual bool search(const T& data) const = 0;
 
-    const std::unique_ptr<BinaryTreeNode<T>>& getRoot() const;
+    virtual size_t nodesCount() const = 0;
+    virtual size_t elementsCount() const = 0;
+    virtual bool empty() const = 0;
+};
 
-protected:
-    bool searchRecursive(const std::unique_ptr<BinaryTreeNode<T>>& node, const T& data) const;
+// Type-erased adapter owning any container with the sorted tree API
+template <typename Tree>
+class TreeAdapter final
+: public BinarySortingTree<typename Tree::value_type, typename Tree::comparator_type> {
+public:
+    using T = typename Tree::value_type;
 
-    std::unique_ptr<BinaryTreeNode<T>> m_root;
-    Comparator m_comparator;
+    template <typename... Args>
+    explicit TreeAdapter(Args&&... args) : m_tree(std::forward<Args>(args)...) {}
 
-    size_t m_nodesCount{0};
-    size_t m_elementsCount{0};
-};
+    void insert(T data) override { m_tree.insert(std::move(data)); }
+    void remove(const T& data) override { m_tree.remove(data); }
+    T removeMin() override { return m_tree.removeMin(); }
+    T removeMax() override { return m_tree.removeMax(); }
 
-template <typename T, typename Comparator>
-BinarySortingTree<T, Comparator>::BinarySortingTree(Comparator comp)
-    : m_root(nullptr), m_comparator(std::move(comp)) {}
+    bool search(const T& data) const override { return m_tree.search(data); }
 
+    size_t nodesCount() const override { return m_tree.nodesCount(); }
+    size_t elementsCount() const override { return m_tree.elementsCount(); }
+    bool empty() const override { return m_tree.empty(); }
 
-template <typename T, typename Comparator>
-bool BinarySortingTree<T, Comparator>::empty() const {
-    return m_root == nullptr;
-}
-    
-template <typename T, typename Comparator>
-const std::unique_ptr<BinaryTreeNode<T>>& BinarySortingTree<T, Comparator>::getRoot() const {
-    return m_root;
-}
+    Tree& tree() { return m_tree; }
+    const Tree& tree() const { return m_tree; }
 
-template <typename T, typename Comparator>
-bool BinarySortingTree<T, Comparator>::searchRecursive(const std::unique_ptr<BinaryTreeNode<T>>& node, const T& data) const {
-    if (!node) return false;
-
-    if (m_comparator(data, node->getData())) {
-        return searchRecursive(node->getLeft(), data);
-    } else if (m_comparator(node->getData(), data)) {
-        return searchRecursive(node->getRight(), data);
-    }
-    return true; // Found the element
-}
+private:
+    Tree m_tree;
+};
 
-} // namespace adsc
\ No newline at end of file
+} // namespace adsc
@@ -1,68 +1,92 @@
 #pragma once
 
-#include "BinarySortingTree.hpp"
+#include "SortedTree.hpp"
+
+#include <utility>
 
 namespace adsc {
 
 template <typename T, typename Comparator = std::less<T>>
-class BinaryTree : public BinarySortingTree<T, Comparator> {
+class BinaryTree : public SortedTree<BinaryTree<T, Comparator>, T, Comparator> {
 public:
     BinaryTree(Comparator comparator = Comparator());
 
-    virtual ~BinaryTree() = default;
+    ~BinaryTree() = default;
+
+    void insert(T data);
+    void remove(const T& data);
+    T removeMin();
+    T removeMax();
 
-    virtual void insert(T data) override;
-    virtual void remove(const T& data) override;
-    virtual T removeMin() override;
-    virtual T removeMax() override;
+    // Bulk variants, O(depth) whatever the count. remove and removeMin/removeMax
+    // take at most the stored copies and report how many were actually removed
+    void insert(T data, uint64_t count);
+    uint64_t remove(const T& data, uint64_t count);
+    std::pair<T, uint64_t> removeMin(uint64_t count);
+    std::pair<T, uint64_t> removeMax(uint64_t count);
 
 protected:
-    using BinarySortingTree<T, Comparator>::m_root;
-    using BinarySortingTree<T, Comparator>::m_comparator;
+    using Base = SortedTree<BinaryTree<T, Comparator>, T, Comparator>;
+    using Base::m_root;
+    using Base::m_comparator;
+
+    // Unbalanced, sorted input makes the tree as deep as it is large. Narrow heights
+    // (CacheAlignedNodeLayout) would wrap past 255 levels
+    static_assert(sizeof(typename Base::node_type::height_type) >= sizeof(uint32_t),
+                  "BinaryTree needs a node height type of at least 32 bits");
 
     using TreeNodePtr = std::unique_ptr<BinaryTreeNode<T>>;
 
 private:
     // Helper for insert
-    void recursive_insert(TreeNodePtr& node, T data);
+    void recursive_insert(TreeNodePtr& node, T data, uint64_t count);
     
     // Helpers for remove
-    void recursive_remove(TreeNodePtr& node, const T& data);
+    uint64_t recursive_remove(TreeNodePtr& node, const T& data, uint64_t count);
     TreeNodePtr extractMin(TreeNodePtr& node);
     
     // Helper for removeMin
-    T recursive_remove_min(TreeNodePtr& node);
+    T recursive_remove_min(TreeNodePtr& node, uint64_t count);
 
     // Helper for removeMax
-    T recursive_remove_max(TreeNodePtr& node);
+    T recursive_remove_max(TreeNodePtr& node, uint64_t count);
 };
 
 template <typename T, typename Comparator>
 BinaryTree<T, Comparator>::BinaryTree(Comparator comparator)
-: BinarySortingTree<T, Comparator>(comparator)
+: Base(comparator)
 {}
 
 template <typename T, typename Comparator>
 void BinaryTree<T, Comparator>::insert(T data) {
-    this->m_elementsCount++;
-    recursive_insert(m_root, std::move(data));
+    insert(std::move(data), 1);
 }
 
 template <typename T, typename Comparator>
-void BinaryTree<T, Comparator>::recursive_insert(TreeNodePtr& node, T data) {
+void BinaryTree<T, Comparator>::insert(T data, uint64_t count) {
+    if (count == 0) {
+        return;
+    }
+    this->addElements(count);
+    recursive_insert(m_root, std::move(data), count);
+}
+
+template <typename T, typename Comparator>
+void BinaryTree<T, Comparator>::recursive_insert(TreeNodePtr& node, T data, uint64_t count) {
     if (!node) {
         this->m_nodesCount++;
-        node = std::make_unique<BinaryTreeNode<T>>(std::move(data));
+        node = std::make_unique<BinaryTreeNode<T>>(std::move(data), count);
+        this->trackInserted(node.get());
         return;
     }
 
     if (data == node->getData()) {
-        node->incrementCount();
+        node->incrementCount(count);
     }else {
         if (m_comparator(data, node->getData())) {
-            recursive_insert(node->getLeft(), std::move(data));
+            recursive_insert(node->getLeft(), std::move(data), count);
         } else {
-            recursive_insert(node->getRight(), std::move(data));
+            recursive_insert(node->getRight(), std::move(data), count);
         }
     }
 
@@ -71,39 +95,60 @@ void BinaryTree<T, Comparator>::recursive_insert(TreeNodePtr& node, T data) {
 
 template <typename T, typename Comparator>
 void BinaryTree<T, Comparator>::remove(const T& data) {
-    recursive_remove(m_root, data);
+    remove(data, 1);
+}
+
+template <typename T, typename Comparator>
+uint64_t BinaryTree<T, Comparator>::remove(const T& data, uint64_t count) {
+    if (this->empty()) {
+        return 0;
+    }
+
+    // Only a removed node equivalent to an extreme can invalidate the cache
+    bool touchesMin = this->isEquivalent(data, this->m_minNode->getData());
+    bool touchesMax = this->isEquivalent(data, this->m_maxNode->getData());
+    size_t nodesBefore = this->m_nodesCount;
+
+    uint64_t removed = recursive_remove(m_root, data, count);
+
+    if (this->m_nodesCount != nodesBefore) {
+        if (touchesMin) this->refreshMin();
+        if (touchesMax) this->refreshMax();
+    }
+    return removed;
 }
 
 template <typename T, typename Comparator>
-void BinaryTree<T, Comparator>::recursive_remove(TreeNodePtr& node, const T& data) {
+uint64_t BinaryTree<T, Comparator>::recursive_remove(TreeNodePtr& node, const T& data, uint64_t count) {
     if (!node){
         // Record not found
-        return;
+        return 0;
     }
 
+    uint64_t removed = 0;
     if (m_comparator(data, node->getData())) {
-        recursive_remove(node->getLeft(), data);
+        removed = recursive_remove(node->getLeft(), data, count);
     } else if (m_comparator(node->getData(), data)) {
-        recursive_remove(node->getRight(), data);
+        removed = recursive_remove(node->getRight(), data, count);
     } else {
         // Data found
-        if (node->decrementCount()) {
-            this->m_elementsCount--;
-            return;
+        removed = std::min(count, node->getCount());
+        this->m_elementsCount -= removed;
+        if (node->decrementCount(removed)) {
+            return removed;
         }
 
         // Remove node with only no or one child
-        this->m_elementsCount--;
         this->m_nodesCount--;  
         if (!node->getLeft()) {
             // Only right child case
             node = std::move(node->getRight());
-            return;
+            return removed;
         } 
         else if (!node->getRight()) {
             // Only left child case
             node = std::move(node->getLeft());
-            return;
+            return removed;
         } 
         else {
             // Two children case
@@ -115,6 +160,7 @@ void BinaryTree<T, Comparator>::recursive_remove(TreeNodePtr& node, const T& dat
     }
 
     node->updateHeight();
+    return removed;
 }
 
 template <typename T, typename Comparator>
@@ -133,60 +179,96 @@ BinaryTree<T, Comparator>::extractMin(TreeNodePtr& node) {
 
 template <typename T, typename Comparator>
 T BinaryTree<T, Comparator>::removeMin() {
+    return removeMin(1).first;
+}
+
+template <typename T, typename Comparator>
+std::pair<T, uint64_t> BinaryTree<T, Comparator>::removeMin(uint64_t count) {
     if (this->empty()) {
         throw std::runtime_error("Tree is empty");
     }
-    this->m_elementsCount--;
-    return std::move(recursive_remove_min(m_root));
+
+    uint64_t removed = std::min(count, this->m_minNode->getCount());
+    this->m_elementsCount -= removed;
+    if (this->m_minNode->getCount() > removed) {
+        // Only decrement count, the cached node spares the spine walk
+        this->m_minNode->decrementCount(removed);
+        return {this->m_minNode->getData(), removed};
+    }
+
+    T outData = recursive_remove_min(m_root, removed);
+    this->refreshMin();
+    if (this->empty()) {
+        this->m_maxNode = nullptr;
+    }
+    return {std::move(outData), removed};
 }
 
 template <typename T, typename Comparator>
-T BinaryTree<T, Comparator>::recursive_remove_min(TreeNodePtr& node) {
+T BinaryTree<T, Comparator>::recursive_remove_min(TreeNodePtr& node, uint64_t count) {
     // Iterate to find min value
     if (node->getLeft()) {
-        T outData = std::move(recursive_remove_min(node->getLeft()));
+        T outData = recursive_remove_min(node->getLeft(), count);
         node->updateHeight();
-        return std::move(outData);
+        return outData;
     }
 
     T outData = std::move(node->getData());
-    if (node->decrementCount()) {
+    if (node->decrementCount(count)) {
         // Only decrement count
-        return std::move(outData);
+        return outData;
     }
     // Replace node with its right child
     this->m_nodesCount--;
     node = std::move(node->getRight());
-    return std::move(outData);
+    return outData;
 }
 
 template <typename T, typename Comparator>
 T BinaryTree<T, Comparator>::removeMax() {
+    return removeMax(1).first;
+}
+
+template <typename T, typename Comparator>
+std::pair<T, uint64_t> BinaryTree<T, Comparator>::removeMax(uint64_t count) {
     if (this->empty()) {
         throw std::runtime_error("Tree is empty");
     }
-    this->m_elementsCount--;
-    return std::move(recursive_remove_max(m_root));
+
+    uint64_t removed = std::min(count, this->m_maxNode->getCount());
+    this->m_elementsCount -= removed;
+    if (this->m_maxNode->getCount() > removed) {
+        // Only decrement count, the cached node spares the spine walk
+        this->m_maxNode->decrementCount(removed);
+        return {this->m_maxNode->getData(), removed};
+    }
+
+    T outData = recursive_remove_max(m_root, removed);
+    this->refreshMax();
+    if (this->empty()) {
+        this->m_minNode = nullptr;
+    }
+    return {std::move(outData), removed};
 }
 
 template <typename T, typename Comparator>
-T BinaryTree<T, Comparator>::recursive_remove_max(TreeNodePtr& node) {
+T BinaryTree<T, Comparator>::recursive_remove_max(TreeNodePtr& node, uint64_t count) {
     // Iterate to find max value
     if (node->getRight()) {
-        T outData = std::move(recursive_remove_max(node->getRight()));
+        T outData = recursive_remove_max(node->getRight(), count);
         node->updateHeight();
-        return std::move(outData);
+        return outData;
     }
 
     T outData = std::move(node->getData());
-    if (node->decrementCount()) {
+    if (node->decrementCount(count)) {
         // Only decrement count
-        return std::move(outData);
+        return outData;
     }
     // Replace node with its left child
     this->m_nodesCount--;
     node = std::move(node->getLeft());  
-    return std::move(outData);
+    return outData;
 }
 
 } // namespace adsc
\ No newline at end of file
@@ -1,73 +1,104 @@
 #pragma once
 
+#include "Augmentation.hpp"
+#include "NodeLayout.hpp"
+
 #include <algorithm>
 #include <cstdint>
+#include <limits>
 #include <memory>
+#include <stdexcept>
 
 namespace adsc {
 
-template <typename T>
-class BinaryTreeNode {
+template <typename T, typename Augmentation = NoAugmentation<T>, typename Layout = DefaultNodeLayout>
+class alignas(Layout::alignment) BinaryTreeNode : public AugmentedValue<Augmentation>, public NodeAllocation<Layout> {
 public:
-    BinaryTreeNode(T data);
+    using height_type = typename Layout::height_type;
+
+    BinaryTreeNode(T data, uint64_t count = 1);
  
     const T& getData() const { return m_data; };
 
-    void setLeft(std::unique_ptr<BinaryTreeNode<T>> left) { m_left = std::move(left); };
-    std::unique_ptr<BinaryTreeNode<T>>& getLeft() {return m_left; };
+    void setLeft(std::unique_ptr<BinaryTreeNode> left) { m_left = std::move(left); };
+    std::unique_ptr<BinaryTreeNode>& getLeft() {return m_left; };
+    const std::unique_ptr<BinaryTreeNode>& getLeft() const {return m_left; };
 
-    void setRight(std::unique_ptr<BinaryTreeNode<T>> right) { m_right = std::move(right); };
-    std::unique_ptr<BinaryTreeNode<T>>& getRight() {return m_right; };
+    void setRight(std::unique_ptr<BinaryTreeNode> right) { m_right = std::move(right); };
+    std::unique_ptr<BinaryTreeNode>& getRight() {return m_right; };
+    const std::unique_ptr<BinaryTreeNode>& getRight() const {return m_right; };
 
-    void incrementCount() { m_count++; }    
-    bool decrementCount();
-    uint32_t getCount() const { return m_count; }   
-    void setCount(uint32_t count) { m_count = count; }
+    // Throws std::overflow_error instead of wrapping around
+    void incrementCount(uint64_t count = 1);
+    // Stops at zero, true while copies are left
+    bool decrementCount(uint64_t count = 1);
+    uint64_t getCount() const { return m_count; }
+    void setCount(uint64_t count) { m_count = count; }
 
     uint32_t getHeight() const { return m_height; }
-    void setHeight(uint32_t height) { m_height = height; }
+    void setHeight(uint32_t height) { m_height = static_cast<height_type>(height); }
 
+    // Also recomputes the subtree aggregate of augmented nodes
     void updateHeight();
     int32_t getNodeBalance() const;
 
 protected:
-    const T m_data;
+    // Read by every descent
+    std::unique_ptr<BinaryTreeNode> m_left;
+    std::unique_ptr<BinaryTreeNode> m_right;
 
-    uint32_t m_count;
+    const T m_data;
 
-    uint32_t m_height;
+    // Only needed on the write path
+    uint64_t m_count;
 
-    std::unique_ptr<BinaryTreeNode<T>> m_left;
-    std::unique_ptr<BinaryTreeNode<T>> m_right;
+    height_type m_height;
 };
 
-template <typename T>
-BinaryTreeNode<T>::BinaryTreeNode(T data)
-: m_data(std::move(data))
-, m_count(1)
-, m_height(1)
-, m_left(nullptr)
+template <typename T, typename Augmentation, typename Layout>
+BinaryTreeNode<T, Augmentation, Layout>::BinaryTreeNode(T data, uint64_t count)
+: m_left(nullptr)
 , m_right(nullptr)
-{}
+, m_data(std::move(data))
+, m_count(count)
+, m_height(1)
+{
+    if constexpr (Augmentation::enabled) {
+        this->m_aggregate = Augmentation::lift(m_data, m_count);
+    }
+}
 
 
-template <typename T>
-bool BinaryTreeNode<T>::decrementCount() {
-    if (m_count > 0) {
-        m_count--;
+template <typename T, typename Augmentation, typename Layout>
+void BinaryTreeNode<T, Augmentation, Layout>::incrementCount(uint64_t count) {
+    if (count > std::numeric_limits<uint64_t>::max() - m_count) {
+        throw std::overflow_error("Count overflow");
     }
+    m_count += count;
+}
+
+template <typename T, typename Augmentation, typename Layout>
+bool BinaryTreeNode<T, Augmentation, Layout>::decrementCount(uint64_t count) {
+    m_count -= std::min(count, m_count);
     return m_count > 0;
 }
 
-template <typename T>
-void BinaryTreeNode<T>::updateHeight() {
+template <typename T, typename Augmentation, typename Layout>
+void BinaryTreeNode<T, Augmentation, Layout>::updateHeight() {
     uint32_t leftHeight = m_left ? m_left->getHeight() : 0;
     uint32_t rightHeight = m_right ? m_right->getHeight() : 0;
-    m_height = 1 + std::max(leftHeight, rightHeight);
+    m_height = static_cast<height_type>(1 + std::max(leftHeight, rightHeight));
+
+    if constexpr (Augmentation::enabled) {
+        auto aggregate = Augmentation::lift(m_data, m_count);
+        if (m_left) aggregate = Augmentation::combine(m_left->getAggregate(), aggregate);
+        if (m_right) aggregate = Augmentation::combine(aggregate, m_right->getAggregate());
+        this->m_aggregate = aggregate;
+    }
 }
 
-template <typename T>
-int32_t BinaryTreeNode<T>::getNodeBalance() const {
+template <typename T, typename Augmentation, typename Layout>
+int32_t BinaryTreeNode<T, Augmentation, Layout>::getNodeBalance() const {
     int32_t leftH = m_left ? m_left->getHeight() : 0;
     int32_t rightH = m_right ? m_right->getHeight() : 0;
     return leftH - rightH;
@@ -0,0 +1,343 @@
+#pragma once
+
+#include "AVLTree.hpp"
+
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+namespace adsc {
+
+// When BufferedTree applies its buffered operations to the tree
+enum class MergeMode { Inline, Background };
+
+// Write-behind front end of an AVLTree (the LSM trade of read cost for ingest rate).
+// insert() and remove() fold into a log holding the net effect per key, O(log b) for
+// b buffered keys. Once the log has taken bufferCapacity operations it is merged into
+// the tree in one ordered pass, either by the writer that filled it (Inline) or by a
+// merge thread (Background) while new operations go to a fresh log. Lookups apply the
+// pending effects on the key to the tree's count, O(log n + log b), so every read sees
+// all writes that completed before it.
+//
+// An operation the tree rejects during a merge (count overflow, bad_alloc) is dropped
+// and its exception passed on: to the writer that ran the merge (Inline) or to the next
+// flush() (Background). The operations not merged yet stay buffered.
+//
+// All members are safe to call from several threads.
+template <typename T, typename Comparator = std::less<T>>
+class BufferedTree {
+public:
+    using value_type = T;
+    using comparator_type = Comparator;
+
+    explicit BufferedTree(size_t bufferCapacity = 1024, MergeMode mode = MergeMode::Inline,
+                          Comparator comp = Comparator());
+    // Merges what is still buffered
+    ~BufferedTree();
+
+    BufferedTree(const BufferedTree&) = delete;
+    BufferedTree& operator=(const BufferedTree&) = delete;
+
+    void insert(T data, uint64_t count = 1);
+    // Removes up to count copies, like AVLTree::remove absent copies are ignored
+    void remove(const T& data, uint64_t count = 1);
+
+    bool search(const T& data) const { return count(data) > 0; };
+    uint64_t count(const T& data) const;
+
+    // Merges every buffered operation and waits until the tree holds them, rethrows
+    // what a background merge failed on since the last flush
+    void flush();
+    size_t bufferedCount() const;
+
+    // Flush, then the counters of the tree
+    size_t nodesCount();
+    size_t elementsCount();
+
+    // Flush, then visits every element in order
+    template <typename Visitor>
+    void forEach(Visitor visit);
+
+private:
+    // Net effect of a run of operations on one key: take up to `removed` copies,
+    // then add `added` copies. Composes in O(1) per operation
+    struct Effect {
+        uint64_t removed{0};
+        uint64_t added{0};
+
+        void apply(uint64_t count, bool insert);
+        uint64_t on(uint64_t count) const { return (count > removed ? count - removed : 0) + added; }
+    };
+
+    using Log = std::map<T, Effect, Comparator>;
+
+    void append(T data, uint64_t count, bool insert);
+    // Helpers for merging, the log being merged is only touched by the merger
+    void handOff(std::unique_lock<std::mutex>& buffer);
+    void mergeFlushing();
+    void restoreFlushing();
+    void finishMerge();
+    void runMerger();
+
+    AVLTree<T, Comparator> m_tree;
+    Comparator m_comparator;
+    size_t m_bufferCapacity;
+    MergeMode m_mode;
+
+    // Lock order: m_treeMutex before m_bufferMutex
+    mutable std::mutex m_treeMutex;
+    mutable std::mutex m_bufferMutex;
+    std::condition_variable m_merged;
+    std::condition_variable m_work;
+
+    // Operations taken by each log, several on one key share an entry
+    Log m_active;
+    Log m_flushing;
+    size_t m_activeOperations{0};
+    size_t m_flushingOperations{0};
+    bool m_flushPending{false};
+    bool m_stop{false};
+    std::exception_ptr m_mergeError;
+    std::thread m_merger;
+};
+
+template <typename T, typename Comparator>
+BufferedTree<T, Comparator>::BufferedTree(size_t bufferCapacity, MergeMode mode, Comparator comp)
+: m_tree(comp)
+, m_comparator(comp)
+, m_bufferCapacity(bufferCapacity)
+, m_mode(mode)
+, m_active(comp)
+, m_flushing(comp)
+{
+    if (bufferCapacity == 0) {
+        throw std::invalid_argument("BufferedTree needs a buffer capacity of at least one");
+    }
+    if (m_mode == MergeMode::Background) {
+        m_merger = std::thread([this] { runMerger(); });
+    }
+}
+
+template <typename T, typename Comparator>
+BufferedTree<T, Comparator>::~BufferedTree() {
+    // Nothing can report a rejected operation here. Every failed merge drops one, so retrying ends
+    while (true) {
+        try {
+            flush();
+            break;
+        } catch (...) {
+        }
+    }
+    if (m_merger.joinable()) {
+        {
+            std::lock_guard<std::mutex> buffer(m_bufferMutex);
+            m_stop = true;
+        }
+        m_work.notify_one();
+        m_merger.join();
+    }
+}
+
+template <typename T, typename Comparator>
+void BufferedTree<T, Comparator>::Effect::apply(uint64_t count, bool insert) {
+    if (insert) {
+        added += count;
+    } else if (count <= added) {
+        added -= count;
+    } else {
+        // The removal eats every added copy and reaches into the tree, saturating
+        uint64_t rest = count - added;
+        removed = rest > std::numeric_limits<uint64_t>::max() - removed ? std::numeric_limits<uint64_t>::max()
+                                                                          : removed + rest;
+        added = 0;
+    }
+}
+
+template <typename T, typename Comparator>
+void BufferedTree<T, Comparator>::insert(T data, uint64_t count) {
+    append(std::move(data), count, true);
+}
+
+template <typename T, typename Comparator>
+void BufferedTree<T, Comparator>::remove(const T& data, uint64_t count) {
+    append(data, count, false);
+}
+
+template <typename T, typename Comparator>
+void BufferedTree<T, Comparator>::append(T data, uint64_t count, bool insert) {
+    std::unique_lock<std::mutex> buffer(m_bufferMutex);
+    m_active.try_emplace(std::move(data)).first->second.apply(count, insert);
+    if (++m_activeOperations < m_bufferCapacity) {
+        return;
+    }
+    handOff(buffer);
+    if (m_mode == MergeMode::Inline) {
+        buffer.unlock();
+        mergeFlushing();
+    }
+}
+
+template <typename T, typename Comparator>
+void BufferedTree<T, Comparator>::handOff(std::unique_lock<std::mutex>& buffer) {
+    // Back pressure, a single log can be merging at a time
+    m_merged.wait(buffer, [this] { return !m_flushPending; });
+    if (m_activeOperations == 0) {
+        return;
+    }
+    // The flushing log was emptied by the last merge
+    m_flushing.swap(m_active);
+    m_flushingOperations = m_activeOperations;
+    m_activeOperations = 0;
+    m_flushPending = true;
+    if (m_mode == MergeMode::Background) {
+        m_work.notify_one();
+    }
+}
+
+template <typename T, typename Comparator>
+void BufferedTree<T, Comparator>::mergeFlushing() {
+    std::lock_guard<std::mutex> tree(m_treeMutex);
+    if (!m_flushPending) {
+        return;
+    }
+
+    // Writers only swap m_flushing once it is cleared below, readers wait for the tree lock.
+    // Keys come out in order, extracted so they can be moved into the tree
+    try {
+        while (!m_flushing.empty()) {
+            auto entry = m_flushing.extract(m_flushing.begin());
+            const Effect& effect = entry.mapped();
+            if (effect.removed > 0) {
+                m_tree.remove(entry.key(), effect.removed);
+            }
+            if (effect.added > 0) {
+                m_tree.insert(std::move(entry.key()), effect.added);
+            }
+        }
+    } catch (...) {
+        // The entry being applied is dropped, the rest go back to the active log. A
+        // background merge keeps the error for flush(), set before waiters wake up
+        std::lock_guard<std::mutex> buffer(m_bufferMutex);
+        restoreFlushing();
+        finishMerge();
+        if (m_mode == MergeMode::Inline) {
+            throw;
+        }
+        m_mergeError = std::current_exception();
+    }
+
+    std::lock_guard<std::mutex> buffer(m_bufferMutex);
+    finishMerge();
+}
+
+template <typename T, typename Comparator>
+void BufferedTree<T, Comparator>::restoreFlushing() {
+    // Both locks held. The flushing entries are older, their effect comes first
+    while (!m_flushing.empty()) {
+        auto entry = m_flushing.extract(m_flushing.begin());
+        auto active = m_active.find(entry.key());
+        if (active == m_active.end()) {
+            m_active.insert(std::move(entry));
+            continue;
+        }
+        Effect effect = entry.mapped();
+        effect.apply(active->second.removed, false);
+        effect.apply(active->second.added, true);
+        active->second = effect;
+    }
+    m_activeOperations += m_flushingOperations;
+}
+
+template <typename T, typename Comparator>
+void BufferedTree<T, Comparator>::finishMerge() {
+    m_flushingOperations = 0;
+    m_flushPending = false;
+    m_merged.notify_all();
+}
+
+template <typename T, typename Comparator>
+void BufferedTree<T, Comparator>::runMerger() {
+    std::unique_lock<std::mutex> buffer(m_bufferMutex);
+    while (true) {
+        m_work.wait(buffer, [this] { return m_flushPending || m_stop; });
+        if (m_flushPending) {
+            buffer.unlock();
+            mergeFlushing();
+            buffer.lock();
+        } else {
+            return;
+        }
+    }
+}
+
+template <typename T, typename Comparator>
+uint64_t BufferedTree<T, Comparator>::count(const T& data) const {
+    std::lock_guard<std::mutex> tree(m_treeMutex);
+    std::lock_guard<std::mutex> buffer(m_bufferMutex);
+
+    // The flushing log is older than the active one
+    uint64_t result = m_tree.count(data);
+    auto fold = [&](const Log& log) {
+        auto entry = log.find(data);
+        if (entry != log.end()) {
+            result = entry->second.on(result);
+        }
+    };
+    if (m_flushPending) {
+        fold(m_flushing);
+    }
+    fold(m_active);
+    return result;
+}
+
+template <typename T, typename Comparator>
+void BufferedTree<T, Comparator>::flush() {
+    std::unique_lock<std::mutex> buffer(m_bufferMutex);
+    handOff(buffer);
+    if (m_mode == MergeMode::Inline) {
+        buffer.unlock();
+        mergeFlushing();
+    } else {
+        m_merged.wait(buffer, [this] { return !m_flushPending; });
+        if (m_mergeError) {
+            std::rethrow_exception(std::exchange(m_mergeError, nullptr));
+        }
+    }
+}
+
+template <typename T, typename Comparator>
+size_t BufferedTree<T, Comparator>::bufferedCount() const {
+    std::lock_guard<std::mutex> buffer(m_bufferMutex);
+    return m_activeOperations + (m_flushPending ? m_flushingOperations : 0);
+}
+
+template <typename T, typename Comparator>
+size_t BufferedTree<T, Comparator>::nodesCount() {
+    flush();
+    std::lock_guard<std::mutex> tree(m_treeMutex);
+    return m_tree.nodesCount();
+}
+
+template <typename T, typename Comparator>
+size_t BufferedTree<T, Comparator>::elementsCount() {
+    flush();
+    std::lock_guard<std::mutex> tree(m_treeMutex);
+    return m_tree.elementsCount();
+}
+
+template <typename T, typename Comparator>
+template <typename Visitor>
+void BufferedTree<T, Comparator>::forEach(Visitor visit) {
+    flush();
+    std::lock_guard<std::mutex> tree(m_treeMutex);
+    m_tree.forEach(visit);
+}
+
+} // namespace adsc
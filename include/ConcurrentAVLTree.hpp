@@ -0,0 +1,467 @@
+#pragma once
+
+#include "AVLBalance.hpp"
+#include "EpochReclaimer.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace adsc {
+
+// AVL tree with lock-free readers and one writer at a time (writers are serialized).
+// Published nodes are immutable: a writer copies the nodes on the path it changes,
+// balances the private copies and publishes the new root with a single store, so a
+// reader always walks one consistent version. Nodes replaced by a write are retired
+// through an EpochReclaimer and freed once every reader pinned before the publish
+// has left.
+//
+// T must be copyable, keys are copied along with the replaced nodes.
+template <typename T, typename Comparator = std::less<T>>
+class ConcurrentAVLTree {
+public:
+    using value_type = T;
+    using comparator_type = Comparator;
+
+    explicit ConcurrentAVLTree(Comparator comp = Comparator());
+    ~ConcurrentAVLTree();
+
+    ConcurrentAVLTree(const ConcurrentAVLTree&) = delete;
+    ConcurrentAVLTree& operator=(const ConcurrentAVLTree&) = delete;
+
+    // Writers, serialized by a mutex
+    void insert(T data) { insert(std::move(data), 1); };
+    void remove(const T& data) { remove(data, 1); };
+    T removeMin() { return removeMin(1).first; };
+    T removeMax() { return removeMax(1).first; };
+
+    void insert(T data, uint64_t count);
+    // Removes up to count copies, returns the number of copies removed
+    uint64_t remove(const T& data, uint64_t count);
+    std::pair<T, uint64_t> removeMin(uint64_t count);
+    std::pair<T, uint64_t> removeMax(uint64_t count);
+
+    // Readers, lock-free
+    bool search(const T& data) const { return count(data) > 0; };
+    uint64_t count(const T& data) const;
+    T min() const;
+    T max() const;
+
+    // Visits every element in order, all from the version published when the call began.
+    // The visitor must not modify the tree
+    template <typename Visitor>
+    void forEach(Visitor visit) const;
+
+    // Exact once the tree is quiescent
+    size_t nodesCount() const { return m_nodesCount.load(std::memory_order_relaxed); };
+    size_t elementsCount() const { return m_elementsCount.load(std::memory_order_relaxed); };
+    bool empty() const { return elementsCount() == 0; };
+    uint32_t getHeight() const;
+
+private:
+    struct Node {
+        T data;
+        uint64_t count;
+        uint32_t height;
+        // Write that allocated the node, nodes of the running write are still private
+        uint64_t version;
+        Node* left;
+        Node* right;
+    };
+
+    struct NodeLinks {
+        Node*& left(Node* node) const { return node->left; }
+        Node*& right(Node* node) const { return node->right; }
+        int32_t balance(const Node* node) const {
+            return static_cast<int32_t>(height(node->left)) - static_cast<int32_t>(height(node->right));
+        }
+        void update(Node* node) const { node->height = 1 + std::max(height(node->left), height(node->right)); }
+    };
+
+    static uint32_t height(const Node* node) { return node ? node->height : 0; }
+
+    // One write, run under m_writerMutex on the private root it returns. A write left
+    // by an exception before publish() frees its private copies and forgets the nodes it
+    // meant to replace, the published tree stays as it was
+    class WriteScope {
+    public:
+        explicit WriteScope(ConcurrentAVLTree& tree);
+        ~WriteScope();
+
+        Node* root() const { return m_tree.m_root.load(std::memory_order_relaxed); }
+        void publish(Node* root);
+
+    private:
+        ConcurrentAVLTree& m_tree;
+        size_t m_nodesCount;
+        size_t m_elementsCount;
+        bool m_published{false};
+    };
+
+    // Helpers for writers, all run inside a WriteScope
+    void own(Node*& node);
+    void discard(Node* node);
+    uint64_t countFrom(const Node* node, const T& data) const;
+
+    void recursive_insert(Node*& node, T& data, uint64_t count);
+    void recursive_remove(Node*& node, const T& data, uint64_t count);
+    Node* extractMin(Node*& node);
+    std::pair<T, uint64_t> recursive_remove_extreme(Node*& node, uint64_t count, bool leftmost);
+    void rebalance(Node*& node);
+
+    template <typename Visitor>
+    static void recursive_for_each(const Node* node, Visitor& visit);
+    static void recursive_delete(Node* node);
+
+    std::atomic<Node*> m_root{nullptr};
+    Comparator m_comparator;
+
+    std::mutex m_writerMutex;
+    uint64_t m_version{0};
+    // Published nodes the running write replaced, retired once the new root is out
+    std::vector<Node*> m_replaced;
+    // Private nodes of the running write, and those of them already unlinked again
+    std::vector<Node*> m_created;
+    std::vector<Node*> m_discarded;
+
+    std::atomic<size_t> m_nodesCount{0};
+    std::atomic<size_t> m_elementsCount{0};
+
+    mutable EpochReclaimer m_reclaimer;
+};
+
+template <typename T, typename Comparator>
+ConcurrentAVLTree<T, Comparator>::ConcurrentAVLTree(Comparator comp)
+: m_comparator(std::move(comp))
+{}
+
+template <typename T, typename Comparator>
+ConcurrentAVLTree<T, Comparator>::~ConcurrentAVLTree() {
+    // Retired nodes are freed by the reclaimer
+    recursive_delete(m_root.load());
+}
+
+template <typename T, typename Comparator>
+void ConcurrentAVLTree<T, Comparator>::recursive_delete(Node* node) {
+    if (!node) return;
+    recursive_delete(node->left);
+    recursive_delete(node->right);
+    delete node;
+}
+
+template <typename T, typename Comparator>
+ConcurrentAVLTree<T, Comparator>::WriteScope::WriteScope(ConcurrentAVLTree& tree)
+: m_tree(tree)
+, m_nodesCount(tree.nodesCount())
+, m_elementsCount(tree.elementsCount())
+{
+    ++m_tree.m_version;
+}
+
+template <typename T, typename Comparator>
+ConcurrentAVLTree<T, Comparator>::WriteScope::~WriteScope() {
+    if (m_published) {
+        return;
+    }
+    // The replaced nodes are still linked from the published root, none of the private ones is
+    for (Node* node : m_tree.m_created) {
+        delete node;
+    }
+    m_tree.m_created.clear();
+    m_tree.m_discarded.clear();
+    m_tree.m_replaced.clear();
+    m_tree.m_nodesCount.store(m_nodesCount, std::memory_order_relaxed);
+    m_tree.m_elementsCount.store(m_elementsCount, std::memory_order_relaxed);
+}
+
+template <typename T, typename Comparator>
+void ConcurrentAVLTree<T, Comparator>::WriteScope::publish(Node* root) {
+    // Release: readers that see the new root see the private nodes fully written
+    m_tree.m_root.store(root, std::memory_order_release);
+    m_published = true;
+
+    // A private node unlinked again was never seen by a reader
+    for (Node* node : m_tree.m_discarded) {
+        delete node;
+    }
+    m_tree.m_discarded.clear();
+    m_tree.m_created.clear();
+    if (m_tree.m_replaced.empty()) {
+        return;
+    }
+    auto guard = m_tree.m_reclaimer.pin();
+    for (Node* node : m_tree.m_replaced) {
+        guard.retire(node);
+    }
+    m_tree.m_replaced.clear();
+}
+
+template <typename T, typename Comparator>
+void ConcurrentAVLTree<T, Comparator>::own(Node*& node) {
+    if (node->version == m_version) {
+        return;
+    }
+    // Both lists grow before the copy, so a throw anywhere leaves them consistent
+    m_replaced.push_back(node);
+    m_created.push_back(nullptr);
+    m_created.back() = new Node(*node);
+    node = m_created.back();
+    node->version = m_version;
+}
+
+template <typename T, typename Comparator>
+void ConcurrentAVLTree<T, Comparator>::discard(Node* node) {
+    if (node->version == m_version) {
+        m_discarded.push_back(node);
+    } else {
+        m_replaced.push_back(node);
+    }
+}
+
+template <typename T, typename Comparator>
+uint64_t ConcurrentAVLTree<T, Comparator>::countFrom(const Node* node, const T& data) const {
+    while (node) {
+        if (m_comparator(data, node->data)) {
+            node = node->left;
+        } else if (m_comparator(node->data, data)) {
+            node = node->right;
+        } else {
+            return node->count;
+        }
+    }
+    return 0;
+}
+
+template <typename T, typename Comparator>
+void ConcurrentAVLTree<T, Comparator>::insert(T data, uint64_t count) {
+    if (count == 0) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(m_writerMutex);
+    WriteScope write(*this);
+    Node* root = write.root();
+
+    if (countFrom(root, data) > std::numeric_limits<uint64_t>::max() - count ||
+        elementsCount() > std::numeric_limits<size_t>::max() - count) {
+        throw std::overflow_error("Count overflow");
+    }
+    recursive_insert(root, data, count);
+    m_elementsCount.store(elementsCount() + count, std::memory_order_relaxed);
+    write.publish(root);
+}
+
+template <typename T, typename Comparator>
+void ConcurrentAVLTree<T, Comparator>::recursive_insert(Node*& node, T& data, uint64_t count) {
+    if (!node) {
+        m_created.push_back(nullptr);
+        m_created.back() = new Node{std::move(data), count, 1, m_version, nullptr, nullptr};
+        node = m_created.back();
+        m_nodesCount.store(nodesCount() + 1, std::memory_order_relaxed);
+        return;
+    }
+
+    own(node);
+    if (m_comparator(data, node->data)) {
+        recursive_insert(node->left, data, count);
+    } else if (m_comparator(node->data, data)) {
+        recursive_insert(node->right, data, count);
+    } else {
+        node->count += count;
+        return;
+    }
+    NodeLinks().update(node);
+    rebalance(node);
+}
+
+template <typename T, typename Comparator>
+uint64_t ConcurrentAVLTree<T, Comparator>::remove(const T& data, uint64_t count) {
+    std::lock_guard<std::mutex> lock(m_writerMutex);
+    WriteScope write(*this);
+    Node* root = write.root();
+
+    // Absent keys return before copying a path that would not change
+    uint64_t removed = std::min(count, countFrom(root, data));
+    if (removed == 0) {
+        return 0;
+    }
+    recursive_remove(root, data, removed);
+    m_elementsCount.store(elementsCount() - removed, std::memory_order_relaxed);
+    write.publish(root);
+    return removed;
+}
+
+template <typename T, typename Comparator>
+void ConcurrentAVLTree<T, Comparator>::recursive_remove(Node*& node, const T& data, uint64_t count) {
+    // The key is known to be present with at least count copies
+    if (m_comparator(data, node->data)) {
+        own(node);
+        recursive_remove(node->left, data, count);
+    } else if (m_comparator(node->data, data)) {
+        own(node);
+        recursive_remove(node->right, data, count);
+    } else if (node->count > count) {
+        own(node);
+        node->count -= count;
+        return;
+    } else {
+        m_nodesCount.store(nodesCount() - 1, std::memory_order_relaxed);
+        Node* removed = node;
+        if (!removed->left || !removed->right) {
+            // The remaining child is published and stays untouched
+            node = removed->left ? removed->left : removed->right;
+            discard(removed);
+            return;
+        }
+        Node* right = removed->right;
+        Node* successor = extractMin(right);
+        successor->left = removed->left;
+        successor->right = right;
+        node = successor;
+        discard(removed);
+    }
+    NodeLinks().update(node);
+    rebalance(node);
+}
+
+template <typename T, typename Comparator>
+typename ConcurrentAVLTree<T, Comparator>::Node* ConcurrentAVLTree<T, Comparator>::extractMin(Node*& node) {
+    // The extracted node is relinked elsewhere, so it comes back as a private copy
+    own(node);
+    if (!node->left) {
+        Node* min = node;
+        node = node->right;
+        return min;
+    }
+    Node* min = extractMin(node->left);
+    NodeLinks().update(node);
+    rebalance(node);
+    return min;
+}
+
+template <typename T, typename Comparator>
+std::pair<T, uint64_t> ConcurrentAVLTree<T, Comparator>::removeMin(uint64_t count) {
+    std::lock_guard<std::mutex> lock(m_writerMutex);
+    WriteScope write(*this);
+    Node* root = write.root();
+    if (!root) {
+        throw std::runtime_error("Tree is empty");
+    }
+    auto removed = recursive_remove_extreme(root, count, true);
+    m_elementsCount.store(elementsCount() - removed.second, std::memory_order_relaxed);
+    write.publish(root);
+    return removed;
+}
+
+template <typename T, typename Comparator>
+std::pair<T, uint64_t> ConcurrentAVLTree<T, Comparator>::removeMax(uint64_t count) {
+    std::lock_guard<std::mutex> lock(m_writerMutex);
+    WriteScope write(*this);
+    Node* root = write.root();
+    if (!root) {
+        throw std::runtime_error("Tree is empty");
+    }
+    auto removed = recursive_remove_extreme(root, count, false);
+    m_elementsCount.store(elementsCount() - removed.second, std::memory_order_relaxed);
+    write.publish(root);
+    return removed;
+}
+
+template <typename T, typename Comparator>
+std::pair<T, uint64_t> ConcurrentAVLTree<T, Comparator>::recursive_remove_extreme(Node*& node, uint64_t count, bool leftmost) {
+    Node* next = leftmost ? node->left : node->right;
+    if (next) {
+        own(node);
+        auto removed = recursive_remove_extreme(leftmost ? node->left : node->right, count, leftmost);
+        NodeLinks().update(node);
+        rebalance(node);
+        return removed;
+    }
+
+    if (node->count > count) {
+        own(node);
+        node->count -= count;
+        return {node->data, count};
+    }
+    std::pair<T, uint64_t> removed(node->data, node->count);
+    m_nodesCount.store(nodesCount() - 1, std::memory_order_relaxed);
+    Node* extreme = node;
+    node = leftmost ? node->right : node->left;
+    discard(extreme);
+    return removed;
+}
+
+template <typename T, typename Comparator>
+void ConcurrentAVLTree<T, Comparator>::rebalance(Node*& node) {
+    // avl::rebalance rewrites the heavy child and, in the double rotation cases, its
+    // inner child, both have to be private copies first
+    NodeLinks links;
+    int32_t balance = links.balance(node);
+    if (balance > 1) {
+        own(node->left);
+        if (links.balance(node->left) < 0) own(node->left->right);
+    } else if (balance < -1) {
+        own(node->right);
+        if (links.balance(node->right) > 0) own(node->right->left);
+    }
+    avl::rebalance(links, node);
+}
+
+template <typename T, typename Comparator>
+uint64_t ConcurrentAVLTree<T, Comparator>::count(const T& data) const {
+    auto guard = m_reclaimer.pin();
+    return countFrom(m_root.load(std::memory_order_acquire), data);
+}
+
+template <typename T, typename Comparator>
+T ConcurrentAVLTree<T, Comparator>::min() const {
+    auto guard = m_reclaimer.pin();
+    const Node* node = m_root.load(std::memory_order_acquire);
+    if (!node) {
+        throw std::runtime_error("Tree is empty");
+    }
+    while (node->left) node = node->left;
+    return node->data;
+}
+
+template <typename T, typename Comparator>
+T ConcurrentAVLTree<T, Comparator>::max() const {
+    auto guard = m_reclaimer.pin();
+    const Node* node = m_root.load(std::memory_order_acquire);
+    if (!node) {
+        throw std::runtime_error("Tree is empty");
+    }
+    while (node->right) node = node->right;
+    return node->data;
+}
+
+template <typename T, typename Comparator>
+uint32_t ConcurrentAVLTree<T, Comparator>::getHeight() const {
+    auto guard = m_reclaimer.pin();
+    return height(m_root.load(std::memory_order_acquire));
+}
+
+template <typename T, typename Comparator>
+template <typename Visitor>
+void ConcurrentAVLTree<T, Comparator>::forEach(Visitor visit) const {
+    auto guard = m_reclaimer.pin();
+    recursive_for_each(m_root.load(std::memory_order_acquire), visit);
+}
+
+template <typename T, typename Comparator>
+template <typename Visitor>
+void ConcurrentAVLTree<T, Comparator>::recursive_for_each(const Node* node, Visitor& visit) {
+    if (!node) return;
+    recursive_for_each(node->left, visit);
+    for (uint64_t i = 0; i < node->count; ++i) {
+        visit(node->data);
+    }
+    recursive_for_each(node->right, visit);
+}
+
+} // namespace adsc
@@ -0,0 +1,367 @@
+#pragma once
+
+#include "EpochReclaimer.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+
+namespace adsc {
+
+// Lock-free skip list (Herlihy/Shavit style) with multiplicity counts.
+// A node whose count dropped to zero is logically deleted, its links are then
+// marked top-down and snipped by any traversal that passes it. Unlinked nodes
+// are reclaimed through an EpochReclaimer.
+template <typename T, typename Comparator = std::less<T>>
+class ConcurrentSkipList {
+public:
+    using value_type = T;
+    using comparator_type = Comparator;
+
+    static constexpr uint32_t kMaxLevel = 32;
+
+    explicit ConcurrentSkipList(Comparator comp = Comparator());
+    ~ConcurrentSkipList();
+
+    ConcurrentSkipList(const ConcurrentSkipList&) = delete;
+    ConcurrentSkipList& operator=(const ConcurrentSkipList&) = delete;
+
+    void insert(T data);
+    void remove(const T& data);
+    T removeMin();
+    T removeMax();
+
+    bool search(const T& data) const;
+
+    // Both counters are exact once the list is quiescent
+    size_t nodesCount() const { return m_nodesCount.load(std::memory_order_relaxed); };
+    size_t elementsCount() const { return m_elementsCount.load(std::memory_order_relaxed); };
+
+    bool empty() const { return elementsCount() == 0; };
+
+private:
+    using Link = std::atomic<uintptr_t>;
+
+    struct Node {
+        Node(T value, uint32_t height)
+        : data(std::move(value)), count(1), owners(2), level(height), next(new Link[height]) {
+            for (uint32_t i = 0; i < level; ++i) next[i].store(0, std::memory_order_relaxed);
+        }
+
+        const T data;
+        std::atomic<uint64_t> count;
+        // The inserter and the deleter both hold a reference, the last one retires the node
+        std::atomic<uint32_t> owners;
+        const uint32_t level;
+        std::unique_ptr<Link[]> next;
+    };
+
+    using Preds = std::array<Link*, kMaxLevel>;
+    using Succs = std::array<Node*, kMaxLevel>;
+
+    static Node* pointer(uintptr_t link) { return reinterpret_cast<Node*>(link & ~uintptr_t(1)); }
+    static bool marked(uintptr_t link) { return link & 1; }
+    static uintptr_t word(Node* node) { return reinterpret_cast<uintptr_t>(node); }
+
+    // Helper for every update, snips marked nodes on the way
+    bool find(const T& data, Preds& preds, Succs& succs);
+    bool tryFind(const T& data, Preds& preds, Succs& succs, bool& found);
+
+    // Helper for insert
+    void linkUpperLevels(Node* node, Preds& preds, Succs& succs);
+
+    // Helpers for removal, the thread taking the last copy owns the deletion
+    bool tryDecrement(Node* node, bool& last);
+    void markLinks(Node* node);
+    void release(Node* node, EpochReclaimer::Guard& guard);
+
+    static uint32_t randomLevel();
+
+    std::array<Link, kMaxLevel> m_head{};
+    // Highest level ever linked, traversals start there instead of kMaxLevel
+    std::atomic<uint32_t> m_level{1};
+    Comparator m_comparator;
+
+    std::atomic<size_t> m_nodesCount{0};
+    std::atomic<size_t> m_elementsCount{0};
+
+    mutable EpochReclaimer m_reclaimer;
+};
+
+template <typename T, typename Comparator>
+ConcurrentSkipList<T, Comparator>::ConcurrentSkipList(Comparator comp)
+: m_comparator(std::move(comp))
+{}
+
+template <typename T, typename Comparator>
+ConcurrentSkipList<T, Comparator>::~ConcurrentSkipList() {
+    // Nodes still linked at level 0 have not been retired yet
+    Node* node = pointer(m_head[0].load());
+    while (node) {
+        Node* next = pointer(node->next[0].load());
+        delete node;
+        node = next;
+    }
+}
+
+template <typename T, typename Comparator>
+uint32_t ConcurrentSkipList<T, Comparator>::randomLevel() {
+    static thread_local uint64_t state =
+        0x9E3779B97F4A7C15ull ^ std::hash<std::thread::id>()(std::this_thread::get_id());
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+
+    uint64_t bits = state;
+    uint32_t level = 1;
+    while (level < kMaxLevel && (bits & 3) == 0) {
+        level++;
+        bits >>= 2;
+    }
+    return level;
+}
+
+template <typename T, typename Comparator>
+bool ConcurrentSkipList<T, Comparator>::find(const T& data, Preds& preds, Succs& succs) {
+    bool found = false;
+    while (!tryFind(data, preds, succs, found)) {
+        // A predecessor changed under us, restart from the head
+    }
+    return found;
+}
+
+template <typename T, typename Comparator>
+bool ConcurrentSkipList<T, Comparator>::tryFind(const T& data, Preds& preds, Succs& succs, bool& found) {
+    Node* pred = nullptr;
+    uint32_t level = m_level.load(std::memory_order_relaxed);
+    for (uint32_t i = kMaxLevel; i-- > level;) {
+        preds[i] = &m_head[i];
+        succs[i] = nullptr;
+    }
+    for (uint32_t i = level; i-- > 0;) {
+        Link* link = pred ? &pred->next[i] : &m_head[i];
+        uintptr_t currWord = link->load();
+        if (marked(currWord)) {
+            return false;
+        }
+
+        Node* curr = pointer(currWord);
+        while (curr) {
+            uintptr_t succWord = curr->next[i].load();
+            if (marked(succWord)) {
+                // Snip the logically deleted node
+                uintptr_t expected = word(curr);
+                if (!link->compare_exchange_strong(expected, word(pointer(succWord)))) {
+                    return false;
+                }
+                curr = pointer(succWord);
+                continue;
+            }
+            if (!m_comparator(curr->data, data)) {
+                break;
+            }
+            pred = curr;
+            link = &curr->next[i];
+            curr = pointer(succWord);
+        }
+        preds[i] = link;
+        succs[i] = curr;
+    }
+    found = succs[0] && !m_comparator(data, succs[0]->data);
+    return true;
+}
+
+template <typename T, typename Comparator>
+void ConcurrentSkipList<T, Comparator>::insert(T data) {
+    auto guard = m_reclaimer.pin();
+    m_elementsCount.fetch_add(1, std::memory_order_relaxed);
+
+    Preds preds;
+    Succs succs;
+    Node* node = nullptr;
+    while (true) {
+        const T& key = node ? node->data : data;
+        if (find(key, preds, succs)) {
+            Node* existing = succs[0];
+            uint64_t count = existing->count.load();
+            while (count > 0) {
+                if (existing->count.compare_exchange_weak(count, count + 1)) {
+                    if (node) {
+                        // Never published
+                        m_nodesCount.fetch_sub(1, std::memory_order_relaxed);
+                        delete node;
+                    }
+                    return;
+                }
+            }
+            // Logically deleted, help unlinking it and retry
+            markLinks(existing);
+            continue;
+        }
+
+        if (!node) {
+            node = new Node(std::move(data), randomLevel());
+            m_nodesCount.fetch_add(1, std::memory_order_relaxed);
+
+            uint32_t level = m_level.load(std::memory_order_relaxed);
+            while (level < node->level && !m_level.compare_exchange_weak(level, node->level)) {
+            }
+        }
+        for (uint32_t i = 0; i < node->level; ++i) {
+            node->next[i].store(word(succs[i]), std::memory_order_relaxed);
+        }
+        uintptr_t expected = word(succs[0]);
+        if (preds[0]->compare_exchange_strong(expected, word(node))) {
+            break;
+        }
+    }
+
+    linkUpperLevels(node, preds, succs);
+    release(node, guard);
+}
+
+template <typename T, typename Comparator>
+void ConcurrentSkipList<T, Comparator>::linkUpperLevels(Node* node, Preds& preds, Succs& succs) {
+    for (uint32_t i = 1; i < node->level; ++i) {
+        while (true) {
+            uintptr_t next = node->next[i].load();
+            if (marked(next)) {
+                // Deleted meanwhile, the remaining levels are not needed anymore
+                return;
+            }
+            if (next != word(succs[i]) && !node->next[i].compare_exchange_strong(next, word(succs[i]))) {
+                continue;
+            }
+            uintptr_t expected = word(succs[i]);
+            if (preds[i]->compare_exchange_strong(expected, word(node))) {
+                break;
+            }
+            find(node->data, preds, succs);
+        }
+    }
+}
+
+template <typename T, typename Comparator>
+void ConcurrentSkipList<T, Comparator>::remove(const T& data) {
+    auto guard = m_reclaimer.pin();
+
+    Preds preds;
+    Succs succs;
+    if (!find(data, preds, succs)) {
+        // Record not found
+        return;
+    }
+    Node* node = succs[0];
+    bool last = false;
+    if (tryDecrement(node, last) && last) {
+        release(node, guard);
+    }
+}
+
+template <typename T, typename Comparator>
+bool ConcurrentSkipList<T, Comparator>::tryDecrement(Node* node, bool& last) {
+    uint64_t count = node->count.load();
+    while (count > 0) {
+        if (node->count.compare_exchange_weak(count, count - 1)) {
+            m_elementsCount.fetch_sub(1, std::memory_order_relaxed);
+            last = count == 1;
+            if (last) {
+                m_nodesCount.fetch_sub(1, std::memory_order_relaxed);
+                markLinks(node);
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+template <typename T, typename Comparator>
+void ConcurrentSkipList<T, Comparator>::markLinks(Node* node) {
+    for (uint32_t i = node->level; i-- > 0;) {
+        uintptr_t next = node->next[i].load();
+        while (!marked(next) && !node->next[i].compare_exchange_weak(next, next | 1)) {
+        }
+    }
+}
+
+template <typename T, typename Comparator>
+void ConcurrentSkipList<T, Comparator>::release(Node* node, EpochReclaimer::Guard& guard) {
+    if (node->owners.fetch_sub(1) != 1) {
+        return;
+    }
+    // Both the inserter and the deleter are done, one more pass unlinks every level
+    Preds preds;
+    Succs succs;
+    find(node->data, preds, succs);
+    guard.retire(node);
+}
+
+template <typename T, typename Comparator>
+T ConcurrentSkipList<T, Comparator>::removeMin() {
+    auto guard = m_reclaimer.pin();
+
+    Node* node = pointer(m_head[0].load());
+    while (node) {
+        bool last = false;
+        if (tryDecrement(node, last)) {
+            T outData = node->data;
+            if (last) release(node, guard);
+            return outData;
+        }
+        node = pointer(node->next[0].load());
+    }
+    throw std::runtime_error("List is empty");
+}
+
+template <typename T, typename Comparator>
+T ConcurrentSkipList<T, Comparator>::removeMax() {
+    auto guard = m_reclaimer.pin();
+
+    while (true) {
+        // Follow the rightmost path, marked nodes included
+        Node* last = nullptr;
+        for (uint32_t i = m_level.load(std::memory_order_relaxed); i-- > 0;) {
+            Node* next = pointer((last ? last->next[i] : m_head[i]).load());
+            while (next) {
+                last = next;
+                next = pointer(last->next[i].load());
+            }
+        }
+        if (!last) {
+            throw std::runtime_error("List is empty");
+        }
+        bool taken = false;
+        if (tryDecrement(last, taken)) {
+            T outData = last->data;
+            if (taken) release(last, guard);
+            return outData;
+        }
+
+        // The last node is already deleted, get it out of the way and retry
+        markLinks(last);
+        Preds preds;
+        Succs succs;
+        find(last->data, preds, succs);
+    }
+}
+
+template <typename T, typename Comparator>
+bool ConcurrentSkipList<T, Comparator>::search(const T& data) const {
+    auto guard = m_reclaimer.pin();
+
+    const Node* pred = nullptr;
+    const Node* curr = nullptr;
+    for (uint32_t i = m_level.load(std::memory_order_relaxed); i-- > 0;) {
+        curr = pointer((pred ? pred->next[i] : m_head[i]).load());
+        while (curr && m_comparator(curr->data, data)) {
+            pred = curr;
+            curr = pointer(curr->next[i].load());
+        }
+    }
+    return curr && !m_comparator(data, curr->data) && curr->count.load() > 0;
+}
+
+} // namespace adsc
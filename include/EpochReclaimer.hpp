@@ -0,0 +1,216 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace adsc {
+
+// Epoch based memory reclamation for lock-free readers.
+// A thread pins the reclaimer for the duration of an operation, nodes unlinked
+// during that operation are retired through the guard and freed only after every
+// thread pinned in an earlier epoch has left.
+//
+// Retired nodes wait in the slot of the guard that retired them. Collection also
+// sweeps the slots no guard holds, so what a thread retired before it stopped using
+// the reclaimer is freed by whoever collects next, not only at destruction.
+//
+// Slots come in blocks, pin() links a new block when every slot is held, so any
+// number of threads can be pinned at once and pin() never waits for a guard.
+class EpochReclaimer {
+    struct Slot;
+
+public:
+    // Slots per block, more than this many threads pinned at once add blocks, kept
+    // until the reclaimer is destroyed
+    static constexpr size_t kSlotsPerBlock = 64;
+
+    class Guard {
+    public:
+        Guard(Guard&& other) noexcept : m_owner(other.m_owner), m_slot(other.m_slot) {
+            other.m_owner = nullptr;
+        }
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+        Guard& operator=(Guard&&) = delete;
+
+        ~Guard() {
+            if (m_owner) m_owner->unpin(*m_slot);
+        }
+
+        // Defers the deletion of an already unlinked node
+        template <typename U>
+        void retire(U* node) {
+            m_owner->retire(*m_slot, node, [](void* p) { delete static_cast<U*>(p); });
+        }
+
+        // Advances the epoch if it can and frees what is past its grace period, for
+        // callers whose retired objects are too large to wait for the next
+        // kCollectInterval retirements
+        void reclaim() {
+            m_owner->tryAdvance();
+            m_owner->collect(*m_slot);
+        }
+
+    private:
+        friend class EpochReclaimer;
+        Guard(EpochReclaimer* owner, Slot* slot) : m_owner(owner), m_slot(slot) {}
+
+        EpochReclaimer* m_owner;
+        Slot* m_slot;
+    };
+
+    EpochReclaimer() = default;
+    ~EpochReclaimer();
+
+    EpochReclaimer(const EpochReclaimer&) = delete;
+    EpochReclaimer& operator=(const EpochReclaimer&) = delete;
+
+    // Guards are not reentrant, a thread must not pin the same reclaimer twice
+    Guard pin();
+
+    uint64_t getEpoch() const { return m_globalEpoch.load(); }
+
+private:
+    static constexpr uint64_t kInactive = std::numeric_limits<uint64_t>::max();
+    static constexpr size_t kCollectInterval = 64;
+
+    struct Retired {
+        void* node;
+        void (*deleter)(void*);
+        uint64_t epoch;
+    };
+
+    struct alignas(64) Slot {
+        std::atomic<bool> claimed{false};
+        std::atomic<uint64_t> epoch{kInactive};
+        // Only touched by the thread currently holding the slot
+        std::vector<Retired> retired;
+        size_t retiredSinceCollect{0};
+    };
+
+    void unpin(Slot& slot);
+    void retire(Slot& slot, void* node, void (*deleter)(void*));
+
+    bool tryAdvance();
+    void collect(Slot& slot);
+    static void collect(Slot& slot, uint64_t epoch);
+
+    struct SlotBlock {
+        std::array<Slot, kSlotsPerBlock> slots;
+        // Only ever set once, from null
+        std::atomic<SlotBlock*> next{nullptr};
+    };
+
+    std::atomic<uint64_t> m_globalEpoch{0};
+    SlotBlock m_slots;
+};
+
+inline EpochReclaimer::~EpochReclaimer() {
+    SlotBlock* block = &m_slots;
+    while (block) {
+        for (Slot& slot : block->slots) {
+            for (const Retired& r : slot.retired) {
+                r.deleter(r.node);
+            }
+        }
+        SlotBlock* next = block->next.load();
+        if (block != &m_slots) delete block;
+        block = next;
+    }
+}
+
+inline EpochReclaimer::Guard EpochReclaimer::pin() {
+    static thread_local size_t hint = std::hash<std::thread::id>()(std::this_thread::get_id());
+
+    SlotBlock* block = &m_slots;
+    while (true) {
+        for (size_t attempt = 0; attempt < kSlotsPerBlock; ++attempt) {
+            size_t index = (hint + attempt) % kSlotsPerBlock;
+            Slot& slot = block->slots[index];
+            if (slot.claimed.load(std::memory_order_relaxed) ||
+                slot.claimed.exchange(true, std::memory_order_acquire)) {
+                continue;
+            }
+
+            hint = index;
+            // Sequentially consistent so no load of the operation is ordered before it
+            slot.epoch.store(m_globalEpoch.load());
+            return Guard(this, &slot);
+        }
+
+        // Every slot of the block is held, move on to the next block or link one
+        SlotBlock* next = block->next.load();
+        if (!next) {
+            auto added = std::make_unique<SlotBlock>();
+            if (block->next.compare_exchange_strong(next, added.get())) {
+                next = added.release();
+            }
+        }
+        block = next;
+    }
+}
+
+inline void EpochReclaimer::unpin(Slot& slot) {
+    slot.epoch.store(kInactive, std::memory_order_release);
+    slot.claimed.store(false, std::memory_order_release);
+}
+
+inline void EpochReclaimer::retire(Slot& slot, void* node, void (*deleter)(void*)) {
+    slot.retired.push_back({node, deleter, m_globalEpoch.load()});
+    if (++slot.retiredSinceCollect >= kCollectInterval) {
+        slot.retiredSinceCollect = 0;
+        tryAdvance();
+        collect(slot);
+    }
+}
+
+inline bool EpochReclaimer::tryAdvance() {
+    uint64_t epoch = m_globalEpoch.load();
+    for (const SlotBlock* block = &m_slots; block; block = block->next.load()) {
+        for (const Slot& slot : block->slots) {
+            uint64_t pinned = slot.epoch.load();
+            if (pinned != kInactive && pinned != epoch) {
+                // Someone still runs in the previous epoch
+                return false;
+            }
+        }
+    }
+    return m_globalEpoch.compare_exchange_strong(epoch, epoch + 1);
+}
+
+inline void EpochReclaimer::collect(Slot& slot) {
+    uint64_t epoch = m_globalEpoch.load();
+    collect(slot, epoch);
+
+    // Claimed only for the sweep, a thread pinning meanwhile takes another slot
+    for (SlotBlock* block = &m_slots; block; block = block->next.load()) {
+        for (Slot& idle : block->slots) {
+            if (&idle == &slot || idle.claimed.load(std::memory_order_relaxed) ||
+                idle.claimed.exchange(true, std::memory_order_acquire)) {
+                continue;
+            }
+            collect(idle, epoch);
+            idle.claimed.store(false, std::memory_order_release);
+        }
+    }
+}
+
+inline void EpochReclaimer::collect(Slot& slot, uint64_t epoch) {
+    // A node retired in epoch e is unreachable for everyone once the epoch reaches e + 2
+    auto reclaimable = [epoch](const Retired& r) { return r.epoch + 2 <= epoch; };
+
+    for (const Retired& r : slot.retired) {
+        if (reclaimable(r)) r.deleter(r.node);
+    }
+    slot.retired.erase(std::remove_if(slot.retired.begin(), slot.retired.end(), reclaimable),
+                       slot.retired.end());
+}
+
+} // namespace adsc
@@ -0,0 +1,239 @@
+#pragma once
+
+#include "NodeLayout.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <new>
+#include <string>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace adsc {
+
+// Where HugePageArena places its memory on a NUMA machine
+enum class NumaPolicy {
+    Local,      // first touch, the kernel default
+    Interleave, // round robin over every online node
+    Bind        // only the given node
+};
+
+struct ArenaStats {
+    // Address space mapped in 2MB aligned chunks
+    size_t mappedBytes;
+    // Handed out and not freed yet
+    size_t allocatedBytes;
+    // Whether the kernel accepted madvise(MADV_HUGEPAGE) / mbind for every chunk
+    bool hugePages;
+    bool numaApplied;
+};
+
+// Node allocator over chunks of anonymous memory aligned to 2MB and advised to use
+// transparent huge pages. A tree much larger than the reach of the TLB with 4KB pages
+// (a few MB) takes a page walk on most levels of a lookup; with 2MB pages the walks
+// mostly hit the cache. Chunks can be interleaved over or bound to NUMA nodes.
+//
+// Freed blocks go to a free list per size class and are reused, chunks are only
+// returned to the system at exit. One arena per policy, shared by every tree using it.
+// Outside Linux the chunks come from aligned operator new, without huge pages or NUMA.
+template <NumaPolicy Policy = NumaPolicy::Local, unsigned NumaNode = 0>
+class HugePageArena {
+public:
+    static constexpr size_t kHugePageSize = size_t(2) << 20;
+    static constexpr size_t kChunkSize = 16 * kHugePageSize;
+
+    static void* allocate(size_t size, size_t alignment);
+    static void deallocate(void* block, size_t size, size_t alignment) noexcept;
+
+    static ArenaStats stats();
+
+private:
+    // Size classes are multiples of 16 bytes up to 1KB, a block of class size s is
+    // aligned to the lowest set bit of s, capped at 64
+    static constexpr size_t kGranule = 16;
+    static constexpr size_t kMaxAlignment = 64;
+    static constexpr size_t kSizeClasses = 64;
+
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    HugePageArena() = default;
+    static HugePageArena& instance();
+
+    static size_t classSize(size_t size, size_t alignment);
+    static bool fromArena(size_t size, size_t alignment);
+
+    void* carve(size_t size);
+    void mapChunk();
+    static bool applyNumaPolicy(void* chunk, size_t length);
+
+    std::mutex m_mutex;
+    std::array<FreeBlock*, kSizeClasses> m_free{};
+    char* m_cursor{nullptr};
+    char* m_end{nullptr};
+    ArenaStats m_stats{0, 0, true, true};
+};
+
+// Nodes allocated from a HugePageArena, for trees of many millions of nodes
+template <NumaPolicy Policy = NumaPolicy::Local, unsigned NumaNode = 0>
+struct HugePageNodeLayout {
+    static constexpr size_t alignment = alignof(std::max_align_t);
+    using height_type = uint32_t;
+    using allocator = HugePageArena<Policy, NumaNode>;
+};
+
+template <NumaPolicy Policy, unsigned NumaNode>
+HugePageArena<Policy, NumaNode>& HugePageArena<Policy, NumaNode>::instance() {
+    // Never destroyed, nodes of static trees may be freed after the arena's destructor would run
+    static HugePageArena* arena = new HugePageArena();
+    return *arena;
+}
+
+template <NumaPolicy Policy, unsigned NumaNode>
+size_t HugePageArena<Policy, NumaNode>::classSize(size_t size, size_t alignment) {
+    size_t unit = alignment > kGranule ? alignment : kGranule;
+    return (size + unit - 1) / unit * unit;
+}
+
+template <NumaPolicy Policy, unsigned NumaNode>
+bool HugePageArena<Policy, NumaNode>::fromArena(size_t size, size_t alignment) {
+    return alignment <= kMaxAlignment && classSize(size, alignment) <= kSizeClasses * kGranule;
+}
+
+template <NumaPolicy Policy, unsigned NumaNode>
+void* HugePageArena<Policy, NumaNode>::allocate(size_t size, size_t alignment) {
+    if (!fromArena(size, alignment)) {
+        return ::operator new(size, std::align_val_t(alignment));
+    }
+    size_t bytes = classSize(size, alignment);
+    HugePageArena& arena = instance();
+
+    std::lock_guard<std::mutex> lock(arena.m_mutex);
+    FreeBlock*& head = arena.m_free[bytes / kGranule - 1];
+    void* block = head;
+    if (head) {
+        head = head->next;
+    } else {
+        block = arena.carve(bytes);
+    }
+    arena.m_stats.allocatedBytes += bytes;
+    return block;
+}
+
+template <NumaPolicy Policy, unsigned NumaNode>
+void HugePageArena<Policy, NumaNode>::deallocate(void* block, size_t size, size_t alignment) noexcept {
+    if (!fromArena(size, alignment)) {
+        ::operator delete(block, size, std::align_val_t(alignment));
+        return;
+    }
+    size_t bytes = classSize(size, alignment);
+    HugePageArena& arena = instance();
+
+    std::lock_guard<std::mutex> lock(arena.m_mutex);
+    arena.m_stats.allocatedBytes -= bytes;
+    FreeBlock*& head = arena.m_free[bytes / kGranule - 1];
+    head = new (block) FreeBlock{head};
+}
+
+template <NumaPolicy Policy, unsigned NumaNode>
+ArenaStats HugePageArena<Policy, NumaNode>::stats() {
+    HugePageArena& arena = instance();
+    std::lock_guard<std::mutex> lock(arena.m_mutex);
+    return arena.m_stats;
+}
+
+template <NumaPolicy Policy, unsigned NumaNode>
+void* HugePageArena<Policy, NumaNode>::carve(size_t size) {
+    size_t alignment = size & (~size + 1);
+    alignment = alignment < kMaxAlignment ? alignment : kMaxAlignment;
+
+    // The tail of a chunk too short for the block is left unused
+    auto aligned = [&] { return (reinterpret_cast<uintptr_t>(m_cursor) + alignment - 1) & ~(alignment - 1); };
+    if (!m_cursor || aligned() + size > reinterpret_cast<uintptr_t>(m_end)) {
+        mapChunk();
+    }
+    char* block = reinterpret_cast<char*>(aligned());
+    m_cursor = block + size;
+    return block;
+}
+
+template <NumaPolicy Policy, unsigned NumaNode>
+void HugePageArena<Policy, NumaNode>::mapChunk() {
+#if defined(__linux__)
+    // Over-map by one huge page and trim, mmap only guarantees 4KB alignment
+    size_t length = kChunkSize + kHugePageSize;
+    void* mapped = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (mapped == MAP_FAILED) {
+        throw std::bad_alloc();
+    }
+    uintptr_t begin = reinterpret_cast<uintptr_t>(mapped);
+    uintptr_t chunk = (begin + kHugePageSize - 1) & ~(kHugePageSize - 1);
+    if (chunk > begin) {
+        munmap(mapped, chunk - begin);
+    }
+    if (chunk + kChunkSize < begin + length) {
+        munmap(reinterpret_cast<void*>(chunk + kChunkSize), begin + length - chunk - kChunkSize);
+    }
+
+    // Both only take effect on pages not touched yet
+#if defined(MADV_HUGEPAGE)
+    m_stats.hugePages &= madvise(reinterpret_cast<void*>(chunk), kChunkSize, MADV_HUGEPAGE) == 0;
+#else
+    m_stats.hugePages = false;
+#endif
+#else
+    uintptr_t chunk = reinterpret_cast<uintptr_t>(::operator new(kChunkSize, std::align_val_t(kHugePageSize)));
+    m_stats.hugePages = false;
+#endif
+    m_stats.numaApplied &= applyNumaPolicy(reinterpret_cast<void*>(chunk), kChunkSize);
+
+    m_cursor = reinterpret_cast<char*>(chunk);
+    m_end = m_cursor + kChunkSize;
+    m_stats.mappedBytes += kChunkSize;
+}
+
+template <NumaPolicy Policy, unsigned NumaNode>
+bool HugePageArena<Policy, NumaNode>::applyNumaPolicy(void* chunk, size_t length) {
+    if (Policy == NumaPolicy::Local) {
+        return true;
+    }
+#if defined(__linux__) && defined(SYS_mbind)
+    // Values of <numaif.h>, called through syscall() so libnuma is not needed
+    constexpr int kBind = 2;
+    constexpr int kInterleave = 3;
+    constexpr size_t kMaxNodes = 64;
+
+    unsigned long mask = 0;
+    if (Policy == NumaPolicy::Bind) {
+        if (NumaNode >= kMaxNodes) return false;
+        mask = 1ul << NumaNode;
+    } else {
+        // Online nodes are listed as ranges, "0-1,3"
+        std::ifstream online("/sys/devices/system/node/online");
+        std::string range;
+        while (std::getline(online, range, ',')) {
+            size_t dash = range.find('-');
+            unsigned long first = std::stoul(range.substr(0, dash));
+            unsigned long last = dash == std::string::npos ? first : std::stoul(range.substr(dash + 1));
+            for (unsigned long node = first; node <= last && node < kMaxNodes; ++node) mask |= 1ul << node;
+        }
+        if (mask == 0) return false;
+    }
+    int mode = Policy == NumaPolicy::Bind ? kBind : kInterleave;
+    return syscall(SYS_mbind, chunk, length, mode, &mask, kMaxNodes + 1, 0) == 0;
+#else
+    (void)chunk;
+    (void)length;
+    return false;
+#endif
+}
+
+} // namespace adsc
@@ -0,0 +1,116 @@
+#pragma once
+
+#include "AVLTree.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace adsc {
+
+// Closed interval [start, end]
+template <typename T>
+struct Interval {
+    T start;
+    T end;
+
+    bool operator==(const Interval& other) const { return start == other.start && end == other.end; }
+    bool operator!=(const Interval& other) const { return !(*this == other); }
+};
+
+template <typename T>
+struct IntervalLess {
+    bool operator()(const Interval<T>& a, const Interval<T>& b) const {
+        return a.start < b.start || (!(b.start < a.start) && a.end < b.end);
+    }
+};
+
+// Largest end point inside a subtree
+template <typename T>
+struct MaxEndpointAugmentation {
+    static constexpr bool enabled = true;
+    using value_type = T;
+
+    static value_type identity() { return std::numeric_limits<T>::lowest(); }
+    static value_type lift(const Interval<T>& data, uint64_t count) { return count > 0 ? data.end : identity(); }
+    static value_type combine(const value_type& left, const value_type& right) { return std::max(left, right); }
+};
+
+// AVLTree ordered by start point, each subtree knows its maximal end point,
+// which lets overlap queries skip every subtree ending before the query starts
+template <typename T>
+class IntervalTree : public AVLTree<Interval<T>, IntervalLess<T>, MaxEndpointAugmentation<T>> {
+public:
+    using Base = AVLTree<Interval<T>, IntervalLess<T>, MaxEndpointAugmentation<T>>;
+    using Base::insert;
+    using Base::remove;
+
+    void insert(T start, T end) { Base::insert(Interval<T>{std::move(start), std::move(end)}); }
+    void remove(const T& start, const T& end) { Base::remove(Interval<T>{start, end}); }
+
+    // Calls visit(interval) once per stored copy of every interval overlapping [start, end],
+    // in start order and without allocating. O(k log n) for k reported intervals.
+    template <typename Visitor>
+    void overlapping(const T& start, const T& end, Visitor&& visit) const;
+
+    bool overlapsAny(const T& start, const T& end) const;
+
+private:
+    using Node = BinaryTreeNode<Interval<T>, MaxEndpointAugmentation<T>>;
+
+    // Helper for overlapping
+    template <typename Visitor>
+    void recursive_overlapping(const Node* node, const T& start, const T& end, Visitor& visit) const;
+};
+
+template <typename T>
+template <typename Visitor>
+void IntervalTree<T>::overlapping(const T& start, const T& end, Visitor&& visit) const {
+    recursive_overlapping(this->getRoot().get(), start, end, visit);
+}
+
+template <typename T>
+template <typename Visitor>
+void IntervalTree<T>::recursive_overlapping(const Node* node, const T& start, const T& end, Visitor& visit) const {
+    if (!node || node->getAggregate() < start) {
+        // Every interval below ends before the query starts
+        return;
+    }
+
+    recursive_overlapping(node->getLeft().get(), start, end, visit);
+
+    const Interval<T>& interval = node->getData();
+    if (end < interval.start) {
+        // This node and its right subtree start after the query ends
+        return;
+    }
+    if (!(interval.end < start)) {
+        for (uint64_t i = 0; i < node->getCount(); ++i) {
+            visit(interval);
+        }
+    }
+
+    recursive_overlapping(node->getRight().get(), start, end, visit);
+}
+
+template <typename T>
+bool IntervalTree<T>::overlapsAny(const T& start, const T& end) const {
+    const Node* node = this->getRoot().get();
+    while (node && !(node->getAggregate() < start)) {
+        const Interval<T>& interval = node->getData();
+        if (node->getCount() > 0 && !(end < interval.start) && !(interval.end < start)) {
+            return true;
+        }
+        // The left subtree holds a candidate whenever its maximal end reaches the query
+        const Node* left = node->getLeft().get();
+        if (left && !(left->getAggregate() < start)) {
+            node = left;
+        } else if (end < interval.start) {
+            return false;
+        } else {
+            node = node->getRight().get();
+        }
+    }
+    return false;
+}
+
+} // namespace adsc
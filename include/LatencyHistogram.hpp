@@ -0,0 +1,136 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <ostream>
+
+namespace adsc {
+
+// HDR style histogram of latencies (any unsigned unit, the benchmark records nanoseconds).
+// Values below 2^kSubBucketBits are counted exactly, above that every power of two range
+// is split into 2^(kSubBucketBits - 1) equal buckets, so a reported percentile is within
+// 1 / 2^(kSubBucketBits - 1) of the recorded value over the whole uint64_t range.
+// Recording is O(1) and never allocates, the buckets live inline (about 58 KiB).
+class LatencyHistogram {
+public:
+    static constexpr int kSubBucketBits = 8;
+
+    LatencyHistogram() { reset(); }
+
+    void record(uint64_t value);
+    // Adds all samples of another histogram
+    void merge(const LatencyHistogram& other);
+    void reset();
+
+    uint64_t count() const { return m_count; };
+    // Extremes and mean are exact, 0 for an empty histogram
+    uint64_t min() const { return m_count ? m_min : 0; };
+    uint64_t max() const { return m_max; };
+    double mean() const { return m_count ? m_sum / static_cast<double>(m_count) : 0.0; };
+
+    // Smallest bucket bound covering the given share (0..100) of the samples, 0 if empty
+    uint64_t valueAtPercentile(double percentile) const;
+
+    // Count, mean, p50, p99, p99.9 and max as a JSON object
+    void printJson(std::ostream& out) const;
+
+private:
+    static constexpr uint64_t kSubBuckets = uint64_t(1) << kSubBucketBits;
+    static constexpr uint64_t kHalfSubBuckets = kSubBuckets / 2;
+    static constexpr size_t kBucketsCount = kSubBuckets + (64 - kSubBucketBits) * kHalfSubBuckets;
+
+    // Helpers for the bucket layout
+    static size_t bucketOf(uint64_t value);
+    static uint64_t upperBoundOf(size_t bucket);
+
+    std::array<uint64_t, kBucketsCount> m_buckets;
+    uint64_t m_count;
+    uint64_t m_min;
+    uint64_t m_max;
+    double m_sum;
+};
+
+inline size_t LatencyHistogram::bucketOf(uint64_t value) {
+    if (value < kSubBuckets) {
+        return static_cast<size_t>(value);
+    }
+#if defined(__GNUC__) || defined(__clang__)
+    int msb = 63 - __builtin_clzll(value);
+#else
+    int msb = 0;
+    for (uint64_t rest = value >> 1; rest; rest >>= 1) msb++;
+#endif
+    int shift = msb - kSubBucketBits + 1;
+    // value >> shift lies in [kHalfSubBuckets, kSubBuckets)
+    return static_cast<size_t>(kSubBuckets + (shift - 1) * kHalfSubBuckets + ((value >> shift) - kHalfSubBuckets));
+}
+
+inline uint64_t LatencyHistogram::upperBoundOf(size_t bucket) {
+    if (bucket < kSubBuckets) {
+        return bucket;
+    }
+    size_t shift = (bucket - kSubBuckets) / kHalfSubBuckets + 1;
+    uint64_t sub = (bucket - kSubBuckets) % kHalfSubBuckets + kHalfSubBuckets;
+    uint64_t width = uint64_t(1) << shift;
+    // The last bucket ends at UINT64_MAX, computed without overflowing
+    return (sub << shift) + (width - 1);
+}
+
+inline void LatencyHistogram::record(uint64_t value) {
+    m_buckets[bucketOf(value)]++;
+    m_count++;
+    m_min = std::min(m_min, value);
+    m_max = std::max(m_max, value);
+    m_sum += static_cast<double>(value);
+}
+
+inline void LatencyHistogram::merge(const LatencyHistogram& other) {
+    for (size_t i = 0; i < kBucketsCount; ++i) {
+        m_buckets[i] += other.m_buckets[i];
+    }
+    m_count += other.m_count;
+    m_min = std::min(m_min, other.m_min);
+    m_max = std::max(m_max, other.m_max);
+    m_sum += other.m_sum;
+}
+
+inline void LatencyHistogram::reset() {
+    m_buckets.fill(0);
+    m_count = 0;
+    m_min = std::numeric_limits<uint64_t>::max();
+    m_max = 0;
+    m_sum = 0.0;
+}
+
+inline uint64_t LatencyHistogram::valueAtPercentile(double percentile) const {
+    if (m_count == 0) {
+        return 0;
+    }
+    percentile = std::min(std::max(percentile, 0.0), 100.0);
+    uint64_t target = static_cast<uint64_t>(std::ceil(percentile / 100.0 * static_cast<double>(m_count)));
+    target = std::max<uint64_t>(target, 1);
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < kBucketsCount; ++i) {
+        seen += m_buckets[i];
+        if (seen >= target) {
+            // The bucket bound may overshoot the largest sample
+            return std::min(upperBoundOf(i), m_max);
+        }
+    }
+    return m_max;
+}
+
+inline void LatencyHistogram::printJson(std::ostream& out) const {
+    out << "{\"count\": " << count()
+        << ", \"mean\": " << mean()
+        << ", \"p50\": " << valueAtPercentile(50.0)
+        << ", \"p99\": " << valueAtPercentile(99.0)
+        << ", \"p99.9\": " << valueAtPercentile(99.9)
+        << ", \"max\": " << max() << "}";
+}
+
+} // namespace adsc
@@ -0,0 +1,210 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <vector>
+
+namespace adsc {
+
+// Read-only learned index (PGM style) over a snapshot of a tree's contents.
+// The distinct keys are stored in a sorted array, piecewise linear segments predict the
+// position of a key within Epsilon slots, and the segments are indexed the same way
+// level by level until a single segment is left. A lookup evaluates one segment per
+// level and binary searches a window of 2 * Epsilon + 2 slots each time.
+//
+// Keys must be arithmetic and ordered by std::less. Later changes to the tree are not
+// reflected, rebuild the index after modifying it.
+template <typename T, size_t Epsilon = 16>
+class LearnedIndex {
+    static_assert(std::is_arithmetic<T>::value, "LearnedIndex needs arithmetic keys");
+    static_assert(Epsilon > 0, "LearnedIndex needs a positive error bound");
+
+public:
+    using value_type = T;
+
+    // Snapshots any SortedTree in O(n)
+    template <typename Tree>
+    explicit LearnedIndex(const Tree& tree);
+
+    bool search(const T& data) const { return count(data) > 0; };
+    // Smallest stored key not less than data, nullptr if there is none
+    const T* lowerBound(const T& data) const;
+    // Multiplicity of data in the snapshot
+    uint64_t count(const T& data) const;
+
+    size_t nodesCount() const { return m_levelKeys[0].size(); };
+    uint64_t elementsCount() const { return m_elementsCount; };
+    size_t segmentsCount() const { return m_segments[0].size(); };
+    size_t levelsCount() const { return m_segments.size(); };
+
+private:
+    // Predicts begin + slope * (key - first) for the keys of [begin, next segment's begin)
+    struct Segment {
+        T first;
+        double slope;
+        size_t begin;
+    };
+
+    // Helpers for the construction
+    static std::vector<Segment> buildSegments(const std::vector<T>& keys);
+
+    // Helpers for lookups
+    size_t predict(size_t level, size_t segment, const T& data) const;
+    template <typename Bound>
+    static size_t searchNear(const std::vector<T>& keys, size_t position, const T& data, Bound bound);
+    size_t position(const T& data) const;
+    template <typename It, typename Before>
+    static It branchlessBound(It first, It last, Before before);
+
+    // m_levelKeys[0] holds the keys, m_levelKeys[i + 1] the first keys of m_segments[i]
+    std::vector<std::vector<T>> m_levelKeys;
+    std::vector<std::vector<Segment>> m_segments;
+    std::vector<uint64_t> m_counts;
+    uint64_t m_elementsCount{0};
+};
+
+template <typename T, size_t Epsilon>
+template <typename Tree>
+LearnedIndex<T, Epsilon>::LearnedIndex(const Tree& tree) {
+    static_assert(std::is_same<typename Tree::comparator_type, std::less<T>>::value,
+                  "LearnedIndex needs a tree ordered by std::less");
+
+    m_levelKeys.emplace_back();
+    tree.forEachDistinct([this](const T& data, uint64_t count) {
+        m_levelKeys[0].push_back(data);
+        m_counts.push_back(count);
+        m_elementsCount += count;
+    });
+
+    // Every level has at most half the segments of the one below, the top holds one
+    do {
+        m_segments.push_back(buildSegments(m_levelKeys.back()));
+        if (m_segments.back().size() <= 1) {
+            break;
+        }
+        std::vector<T> firsts;
+        for (const Segment& segment : m_segments.back()) {
+            firsts.push_back(segment.first);
+        }
+        m_levelKeys.push_back(std::move(firsts));
+    } while (true);
+}
+
+template <typename T, size_t Epsilon>
+auto LearnedIndex<T, Epsilon>::buildSegments(const std::vector<T>& keys) -> std::vector<Segment> {
+    // Shrinking cone: keep the range of slopes that predicts every key of the segment
+    // within Epsilon and start a new segment once the range is empty, O(n)
+    std::vector<Segment> segments;
+    double lowSlope = 0.0;
+    double highSlope = 0.0;
+    for (size_t i = 0; i < keys.size(); ++i) {
+        if (!segments.empty() && i > segments.back().begin) {
+            const Segment& segment = segments.back();
+            double distance = static_cast<double>(keys[i]) - static_cast<double>(segment.first);
+            double offset = static_cast<double>(i - segment.begin);
+            double low = (offset - static_cast<double>(Epsilon)) / distance;
+            double high = (offset + static_cast<double>(Epsilon)) / distance;
+            if (i == segment.begin + 1) {
+                lowSlope = low;
+                highSlope = high;
+            } else {
+                lowSlope = std::max(lowSlope, low);
+                highSlope = std::min(highSlope, high);
+            }
+            if (lowSlope <= highSlope) {
+                segments.back().slope = std::max(0.0, (lowSlope + highSlope) / 2);
+                continue;
+            }
+        }
+        segments.push_back({keys[i], 0.0, i});
+    }
+    return segments;
+}
+
+template <typename T, size_t Epsilon>
+size_t LearnedIndex<T, Epsilon>::predict(size_t level, size_t segment, const T& data) const {
+    const std::vector<Segment>& segments = m_segments[level];
+    const Segment& current = segments[segment];
+    size_t end = segment + 1 < segments.size() ? segments[segment + 1].begin : m_levelKeys[level].size();
+
+    double offset = current.slope * (static_cast<double>(data) - static_cast<double>(current.first));
+    if (!(offset > 0.0)) {
+        return current.begin;
+    }
+    // Keys past the segment's last key rank right before the next segment
+    if (offset >= static_cast<double>(end - current.begin)) {
+        return end;
+    }
+    return current.begin + static_cast<size_t>(offset);
+}
+
+template <typename T, size_t Epsilon>
+template <typename Bound>
+size_t LearnedIndex<T, Epsilon>::searchNear(const std::vector<T>& keys, size_t position, const T& data, Bound bound) {
+    size_t begin = position > Epsilon + 1 ? position - Epsilon - 1 : 0;
+    size_t end = std::min(keys.size(), position + Epsilon + 2);
+    size_t found = bound(keys.begin() + begin, keys.begin() + end, data) - keys.begin();
+
+    // Rounding can only push a query outside its window near the limits of double,
+    // a whole array search keeps the answer exact there
+    bool beforeWindow = begin > 0 && found == begin && bound(keys.begin() + begin - 1, keys.begin() + begin, data) == keys.begin() + begin - 1;
+    bool afterWindow = end < keys.size() && found == end && bound(keys.begin() + end, keys.begin() + end + 1, data) != keys.begin() + end;
+    if (beforeWindow || afterWindow) {
+        return bound(keys.begin(), keys.end(), data) - keys.begin();
+    }
+    return found;
+}
+
+template <typename T, size_t Epsilon>
+template <typename It, typename Before>
+It LearnedIndex<T, Epsilon>::branchlessBound(It first, It last, Before before) {
+    // First element not before the key; the window is small, halving it with conditional
+    // moves beats the mispredicted branches of std::lower_bound
+    size_t length = last - first;
+    if (length == 0) {
+        return first;
+    }
+    while (length > 1) {
+        size_t half = length / 2;
+        first = before(first[half - 1]) ? first + half : first;
+        length -= half;
+    }
+    return before(*first) ? first + 1 : first;
+}
+
+template <typename T, size_t Epsilon>
+size_t LearnedIndex<T, Epsilon>::position(const T& data) const {
+    auto upper = [](auto first, auto last, const T& key) { return branchlessBound(first, last, [&key](const T& x) { return !(key < x); }); };
+    auto lower = [](auto first, auto last, const T& key) { return branchlessBound(first, last, [&key](const T& x) { return x < key; }); };
+
+    // Descend from the single top segment to the segment of the keys array
+    size_t segment = 0;
+    for (size_t level = m_segments.size() - 1; level > 0; --level) {
+        size_t next = searchNear(m_levelKeys[level], predict(level, segment, data), data, upper);
+        segment = next > 0 ? next - 1 : 0;
+    }
+    return searchNear(m_levelKeys[0], predict(0, segment, data), data, lower);
+}
+
+template <typename T, size_t Epsilon>
+const T* LearnedIndex<T, Epsilon>::lowerBound(const T& data) const {
+    if (m_levelKeys[0].empty()) {
+        return nullptr;
+    }
+    size_t found = position(data);
+    return found < m_levelKeys[0].size() ? &m_levelKeys[0][found] : nullptr;
+}
+
+template <typename T, size_t Epsilon>
+uint64_t LearnedIndex<T, Epsilon>::count(const T& data) const {
+    if (m_levelKeys[0].empty()) {
+        return 0;
+    }
+    size_t found = position(data);
+    bool present = found < m_levelKeys[0].size() && !(data < m_levelKeys[0][found]);
+    return present ? m_counts[found] : 0;
+}
+
+} // namespace adsc
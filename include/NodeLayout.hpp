@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+
+namespace adsc {
+
+// Layout policies decide how a tree node sits in memory:
+//   alignment      alignas of the node, at least alignof(std::max_align_t)
+//   height_type    storage of the subtree height
+//   allocator      optional, allocate(size, alignment) / deallocate(p, size, alignment)
+//                  used for the nodes instead of operator new (see HugePageArena.hpp)
+// Nodes order their fields hot first: children and key are read on every descent,
+// count, height and aggregate only on the write path.
+
+// Aligned like any allocation of operator new, nodes cost no extra padding
+struct DefaultNodeLayout {
+    static constexpr size_t alignment = alignof(std::max_align_t);
+    using height_type = uint32_t;
+};
+
+// One cache line per node for balanced trees. 8 bits hold any AVL height, a tree
+// of height 255 would need more than 2^128 nodes. Unbalanced trees must keep the default,
+// BinaryTree rejects narrower heights at compile time.
+struct CacheAlignedNodeLayout {
+    static constexpr size_t alignment = 64;
+    using height_type = uint8_t;
+};
+
+// Base of the nodes, routes their operator new/delete to the layout's allocator if it has one
+template <typename Layout, typename = void>
+struct NodeAllocation {};
+
+template <typename Layout>
+struct NodeAllocation<Layout, std::void_t<typename Layout::allocator>> {
+    static void* operator new(size_t size) {
+        return Layout::allocator::allocate(size, alignof(std::max_align_t));
+    }
+    static void* operator new(size_t size, std::align_val_t alignment) {
+        return Layout::allocator::allocate(size, static_cast<size_t>(alignment));
+    }
+    static void operator delete(void* node, size_t size) noexcept {
+        Layout::allocator::deallocate(node, size, alignof(std::max_align_t));
+    }
+    static void operator delete(void* node, size_t size, std::align_val_t alignment) noexcept {
+        Layout::allocator::deallocate(node, size, static_cast<size_t>(alignment));
+    }
+};
+
+} // namespace adsc
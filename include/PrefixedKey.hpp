@@ -0,0 +1,98 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <type_traits>
+
+namespace adsc {
+
+// Order preserving 64-bit prefix of a key: of(a) < of(b) implies a < b, equal
+// prefixes say nothing. Specialize it for other key types.
+template <typename T>
+struct KeyPrefix;
+
+namespace detail {
+
+// Packs the first 8 bytes big-endian, shorter keys are padded with zeros
+template <bool SignedBytes>
+uint64_t packPrefix(const char* bytes, size_t size) {
+    uint64_t prefix = 0;
+    for (size_t i = 0; i < 8; ++i) {
+        unsigned char byte = i < size ? static_cast<unsigned char>(bytes[i]) : 0;
+        if (SignedBytes && i < size) {
+            // Signed chars compare with the sign bit flipped
+            byte ^= 0x80;
+        }
+        prefix = (prefix << 8) | byte;
+    }
+    return prefix;
+}
+
+} // namespace detail
+
+template <size_t N>
+struct KeyPrefix<std::array<char, N>> {
+    static uint64_t of(const std::array<char, N>& key) {
+        return detail::packPrefix<std::is_signed<char>::value>(key.data(), N);
+    }
+};
+
+template <size_t N>
+struct KeyPrefix<std::array<unsigned char, N>> {
+    static uint64_t of(const std::array<unsigned char, N>& key) {
+        return detail::packPrefix<false>(reinterpret_cast<const char*>(key.data()), N);
+    }
+};
+
+template <>
+struct KeyPrefix<std::string> {
+    // std::string compares its characters as unsigned char
+    static uint64_t of(const std::string& key) {
+        return detail::packPrefix<false>(key.data(), key.size());
+    }
+};
+
+// Large key kept out of line behind a small inline prefix. Most comparisons of a
+// descent are settled by the prefix and never touch the key's cache lines.
+template <typename T>
+class PrefixedKey {
+public:
+    PrefixedKey(T key)
+    : m_prefix(KeyPrefix<T>::of(key)), m_key(std::make_unique<const T>(std::move(key))) {}
+
+    PrefixedKey(const PrefixedKey& other)
+    : m_prefix(other.m_prefix), m_key(std::make_unique<const T>(*other.m_key)) {}
+    PrefixedKey(PrefixedKey&& other) noexcept = default;
+
+    PrefixedKey& operator=(const PrefixedKey& other) {
+        m_prefix = other.m_prefix;
+        m_key = std::make_unique<const T>(*other.m_key);
+        return *this;
+    }
+    PrefixedKey& operator=(PrefixedKey&& other) noexcept = default;
+
+    const T& get() const { return *m_key; }
+    uint64_t prefix() const { return m_prefix; }
+
+    friend bool operator<(const PrefixedKey& a, const PrefixedKey& b) {
+        if (a.m_prefix != b.m_prefix) {
+            return a.m_prefix < b.m_prefix;
+        }
+        return *a.m_key < *b.m_key;
+    }
+
+    friend bool operator==(const PrefixedKey& a, const PrefixedKey& b) {
+        return a.m_prefix == b.m_prefix && *a.m_key == *b.m_key;
+    }
+
+    friend bool operator!=(const PrefixedKey& a, const PrefixedKey& b) { return !(a == b); }
+    friend bool operator>(const PrefixedKey& a, const PrefixedKey& b) { return b < a; }
+
+private:
+    uint64_t m_prefix;
+    std::unique_ptr<const T> m_key;
+};
+
+} // namespace adsc
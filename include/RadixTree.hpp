@@ -0,0 +1,788 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace adsc {
+
+// Order preserving byte encoding of a key: keys compare like their encodings compared
+// byte by byte as unsigned values, a shorter encoding first on a common prefix
+template <typename T, typename = void>
+struct RadixKey;
+
+// Big endian with the sign bit flipped
+template <typename T>
+struct RadixKey<T, std::enable_if_t<std::is_integral<T>::value>> {
+    static std::array<uint8_t, sizeof(T)> encode(T key) {
+        using U = std::make_unsigned_t<T>;
+        U bits = static_cast<U>(key);
+        if (std::is_signed<T>::value) {
+            bits ^= U(1) << (sizeof(T) * 8 - 1);
+        }
+        std::array<uint8_t, sizeof(T)> bytes;
+        for (size_t i = 0; i < sizeof(T); ++i) {
+            bytes[i] = static_cast<uint8_t>(bits >> (8 * (sizeof(T) - 1 - i)));
+        }
+        return bytes;
+    }
+};
+
+// std::less<std::string> already compares bytes as unsigned char
+template <>
+struct RadixKey<std::string> {
+    static std::string_view encode(const std::string& key) { return key; }
+};
+
+// Adaptive radix tree (ART) with the sorted tree API and multiplicity counts.
+// Keys are descended byte by byte, inner nodes grow and shrink between 4, 16, 48 and
+// 256 children, and chains of single-child nodes are compressed into a prefix stored
+// in the node below. A key that is a proper prefix of others sits in the terminal
+// slot of the node where it ends, so keys of any length can be mixed.
+//
+// Lookups cost O(key length) whatever the number of keys, insert/remove/removeMin also
+// touch at most one node per byte. Ordering is the byte order of RadixKey<T>.
+template <typename T>
+class RadixTree {
+public:
+    using value_type = T;
+    using comparator_type = std::less<T>;
+
+    RadixTree() = default;
+    ~RadixTree() = default;
+
+    RadixTree(RadixTree&&) = default;
+    RadixTree& operator=(RadixTree&&) = default;
+
+    void insert(T data) { insert(std::move(data), 1); };
+    void insert(T data, uint64_t count);
+    void remove(const T& data) { remove(data, 1); };
+    uint64_t remove(const T& data, uint64_t count);
+
+    T removeMin() { return removeMin(1).first; };
+    T removeMax() { return removeMax(1).first; };
+    std::pair<T, uint64_t> removeMin(uint64_t count);
+    std::pair<T, uint64_t> removeMax(uint64_t count);
+
+    bool search(const T& data) const { return count(data) > 0; };
+    uint64_t count(const T& data) const;
+
+    const T& min() const;
+    const T& max() const;
+
+    // Visits every element in order, once per copy
+    template <typename Visitor>
+    void forEach(Visitor visit) const;
+    // Visits every distinct element in order as visit(data, count)
+    template <typename Visitor>
+    void forEachDistinct(Visitor visit) const;
+
+    size_t nodesCount() const { return m_nodesCount; };
+    size_t elementsCount() const { return m_elementsCount; };
+    bool empty() const { return m_nodesCount == 0; };
+
+private:
+    enum class NodeType : uint8_t { Leaf, Node4, Node16, Node48, Node256 };
+
+    struct Node {
+        explicit Node(NodeType nodeType) : type(nodeType) {}
+        NodeType type;
+    };
+
+    // Frees a node through its type tag, nodes carry no vtable
+    struct NodeDeleter {
+        void operator()(Node* node) const;
+    };
+    using NodePtr = std::unique_ptr<Node, NodeDeleter>;
+    using Bytes = decltype(RadixKey<T>::encode(std::declval<const T&>()));
+
+    struct Leaf : Node {
+        Leaf(T leafData, uint64_t leafCount) : Node(NodeType::Leaf), data(std::move(leafData)), count(leafCount) {}
+        T data;
+        uint64_t count;
+    };
+
+    struct Inner : Node {
+        using Node::Node;
+        uint16_t childrenCount{0};
+        // Compressed path between the parent's byte and this node's children
+        std::string prefix;
+        // Leaf of the key ending right after the prefix
+        NodePtr terminal;
+    };
+
+    // Node4 and Node16, keys sorted in the first childrenCount slots
+    template <size_t N, NodeType Type>
+    struct SmallNode : Inner {
+        SmallNode() : Inner(Type) {}
+
+        NodePtr* find(uint8_t byte) {
+#if defined(__SSE2__)
+            if constexpr (N == 16) {
+                // Compare all 16 keys at once
+                __m128i match = _mm_cmpeq_epi8(_mm_set1_epi8(static_cast<char>(byte)),
+                                               _mm_loadu_si128(reinterpret_cast<const __m128i*>(keys.data())));
+                unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(match)) & ((1u << this->childrenCount) - 1);
+                return mask ? &children[__builtin_ctz(mask)] : nullptr;
+            }
+#endif
+            for (size_t i = 0; i < this->childrenCount; ++i) {
+                if (keys[i] == byte) return &children[i];
+            }
+            return nullptr;
+        }
+
+        // Keeps keys sorted, the node must not be full
+        void add(uint8_t byte, NodePtr child) {
+            size_t position = 0;
+            while (position < this->childrenCount && keys[position] < byte) position++;
+            for (size_t i = this->childrenCount; i > position; --i) {
+                keys[i] = keys[i - 1];
+                children[i] = std::move(children[i - 1]);
+            }
+            keys[position] = byte;
+            children[position] = std::move(child);
+            this->childrenCount++;
+        }
+
+        void erase(uint8_t byte) {
+            size_t position = 0;
+            while (keys[position] != byte) position++;
+            for (size_t i = position + 1; i < this->childrenCount; ++i) {
+                keys[i - 1] = keys[i];
+                children[i - 1] = std::move(children[i]);
+            }
+            this->childrenCount--;
+            children[this->childrenCount].reset();
+        }
+
+        std::array<uint8_t, N> keys{};
+        std::array<NodePtr, N> children;
+    };
+    using Node4 = SmallNode<4, NodeType::Node4>;
+    using Node16 = SmallNode<16, NodeType::Node16>;
+
+    struct Node48 : Inner {
+        static constexpr uint8_t kEmpty = 0xFF;
+        Node48() : Inner(NodeType::Node48) { index.fill(kEmpty); }
+
+        // Slot in children of every byte, kEmpty if absent
+        std::array<uint8_t, 256> index;
+        std::array<NodePtr, 48> children;
+    };
+
+    struct Node256 : Inner {
+        Node256() : Inner(NodeType::Node256) {}
+        std::array<NodePtr, 256> children;
+    };
+
+    static uint8_t byteAt(const Bytes& bytes, size_t i) { return static_cast<uint8_t>(bytes[i]); }
+    static NodePtr makeLeaf(T data, uint64_t count) { return NodePtr(new Leaf(std::move(data), count)); }
+    static void addCount(uint64_t& stored, uint64_t count);
+
+    // Helpers for inner nodes
+    static NodePtr* findChild(Inner* node, uint8_t byte);
+    static const Node* childAt(const Inner* node, uint8_t byte);
+    static void addChild(NodePtr& slot, uint8_t byte, NodePtr child);
+    static void removeChild(NodePtr& slot, uint8_t byte);
+    static void shrink(NodePtr& slot);
+    template <typename Target, typename Source>
+    static NodePtr moveInner(Source* source);
+    static const Node* firstChild(const Inner* node);
+    static const Node* lastChild(const Inner* node);
+    template <typename Visitor>
+    static void forEachChild(const Inner* node, Visitor visit);
+    // Bytes of the prefix matching bytes from depth on
+    static size_t matchPrefix(const Inner* node, const Bytes& bytes, size_t depth);
+
+    // Helper for insert
+    // bytes may view into data, it must not be read once data is moved into a leaf
+    void recursive_insert(NodePtr& slot, const Bytes& bytes, size_t depth, T& data, uint64_t count);
+    // Helper for remove
+    uint64_t recursive_remove(NodePtr& slot, const Bytes& bytes, size_t depth, uint64_t count);
+    // Helper for removeMin/removeMax
+    std::pair<T, uint64_t> removeExtreme(const T& extreme, uint64_t count);
+    // Helper for forEachDistinct
+    template <typename Visitor>
+    static void recursive_for_each(const Node* node, Visitor& visit);
+
+    NodePtr m_root;
+    size_t m_nodesCount{0};
+    size_t m_elementsCount{0};
+};
+
+template <typename T>
+void RadixTree<T>::NodeDeleter::operator()(Node* node) const {
+    switch (node->type) {
+        case NodeType::Leaf: delete static_cast<Leaf*>(node); break;
+        case NodeType::Node4: delete static_cast<Node4*>(node); break;
+        case NodeType::Node16: delete static_cast<Node16*>(node); break;
+        case NodeType::Node48: delete static_cast<Node48*>(node); break;
+        case NodeType::Node256: delete static_cast<Node256*>(node); break;
+    }
+}
+
+template <typename T>
+void RadixTree<T>::addCount(uint64_t& stored, uint64_t count) {
+    if (count > std::numeric_limits<uint64_t>::max() - stored) {
+        throw std::overflow_error("Count overflow");
+    }
+    stored += count;
+}
+
+template <typename T>
+auto RadixTree<T>::findChild(Inner* node, uint8_t byte) -> NodePtr* {
+    switch (node->type) {
+        case NodeType::Node4: return static_cast<Node4*>(node)->find(byte);
+        case NodeType::Node16: return static_cast<Node16*>(node)->find(byte);
+        case NodeType::Node48: {
+            Node48* node48 = static_cast<Node48*>(node);
+            uint8_t slot = node48->index[byte];
+            return slot == Node48::kEmpty ? nullptr : &node48->children[slot];
+        }
+        default: {
+            NodePtr& child = static_cast<Node256*>(node)->children[byte];
+            return child ? &child : nullptr;
+        }
+    }
+}
+
+template <typename T>
+auto RadixTree<T>::childAt(const Inner* node, uint8_t byte) -> const Node* {
+    // Lookups never modify the node, the slot is only read
+    NodePtr* child = findChild(const_cast<Inner*>(node), byte);
+    return child ? child->get() : nullptr;
+}
+
+template <typename T>
+template <typename Target, typename Source>
+auto RadixTree<T>::moveInner(Source* source) -> NodePtr {
+    Target* target = new Target();
+    target->prefix = std::move(source->prefix);
+    target->terminal = std::move(source->terminal);
+    return NodePtr(target);
+}
+
+template <typename T>
+void RadixTree<T>::addChild(NodePtr& slot, uint8_t byte, NodePtr child) {
+    Inner* node = static_cast<Inner*>(slot.get());
+    switch (node->type) {
+        case NodeType::Node4: {
+            Node4* node4 = static_cast<Node4*>(node);
+            if (node4->childrenCount < 4) {
+                node4->add(byte, std::move(child));
+                return;
+            }
+            // Grow into a Node16, same sorted layout
+            NodePtr grown = moveInner<Node16>(node4);
+            Node16* node16 = static_cast<Node16*>(grown.get());
+            for (size_t i = 0; i < 4; ++i) {
+                node16->keys[i] = node4->keys[i];
+                node16->children[i] = std::move(node4->children[i]);
+            }
+            node16->childrenCount = 4;
+            node16->add(byte, std::move(child));
+            slot = std::move(grown);
+            return;
+        }
+        case NodeType::Node16: {
+            Node16* node16 = static_cast<Node16*>(node);
+            if (node16->childrenCount < 16) {
+                node16->add(byte, std::move(child));
+                return;
+            }
+            NodePtr grown = moveInner<Node48>(node16);
+            Node48* node48 = static_cast<Node48*>(grown.get());
+            for (uint8_t i = 0; i < 16; ++i) {
+                node48->index[node16->keys[i]] = i;
+                node48->children[i] = std::move(node16->children[i]);
+            }
+            node48->childrenCount = 16;
+            slot = std::move(grown);
+            addChild(slot, byte, std::move(child));
+            return;
+        }
+        case NodeType::Node48: {
+            Node48* node48 = static_cast<Node48*>(node);
+            if (node48->childrenCount < 48) {
+                uint8_t position = 0;
+                while (node48->children[position]) {
+                    position++;
+                }
+                node48->index[byte] = position;
+                node48->children[position] = std::move(child);
+                node48->childrenCount++;
+                return;
+            }
+            NodePtr grown = moveInner<Node256>(node48);
+            Node256* node256 = static_cast<Node256*>(grown.get());
+            for (size_t b = 0; b < 256; ++b) {
+                if (node48->index[b] != Node48::kEmpty) {
+                    node256->children[b] = std::move(node48->children[node48->index[b]]);
+                }
+            }
+            node256->childrenCount = 48;
+            slot = std::move(grown);
+            addChild(slot, byte, std::move(child));
+            return;
+        }
+        default: {
+            Node256* node256 = static_cast<Node256*>(node);
+            node256->children[byte] = std::move(child);
+            node256->childrenCount++;
+            return;
+        }
+    }
+}
+
+template <typename T>
+void RadixTree<T>::removeChild(NodePtr& slot, uint8_t byte) {
+    Inner* node = static_cast<Inner*>(slot.get());
+    switch (node->type) {
+        case NodeType::Node4: static_cast<Node4*>(node)->erase(byte); break;
+        case NodeType::Node16: static_cast<Node16*>(node)->erase(byte); break;
+        case NodeType::Node48: {
+            Node48* node48 = static_cast<Node48*>(node);
+            node48->children[node48->index[byte]].reset();
+            node48->index[byte] = Node48::kEmpty;
+            node48->childrenCount--;
+            break;
+        }
+        default: {
+            static_cast<Node256*>(node)->children[byte].reset();
+            node->childrenCount--;
+            break;
+        }
+    }
+    shrink(slot);
+}
+
+template <typename T>
+void RadixTree<T>::shrink(NodePtr& slot) {
+    // Thresholds below the growth points, a node at a boundary does not flip back and forth
+    Inner* node = static_cast<Inner*>(slot.get());
+    switch (node->type) {
+        case NodeType::Node4: {
+            Node4* node4 = static_cast<Node4*>(node);
+            if (node4->childrenCount == 0) {
+                // Only the terminal is left (an inner node always holds two entries)
+                NodePtr terminal = std::move(node4->terminal);
+                slot = std::move(terminal);
+            } else if (node4->childrenCount == 1 && !node4->terminal) {
+                // Path compression, the single child absorbs this node's prefix
+                NodePtr child = std::move(node4->children[0]);
+                if (child->type != NodeType::Leaf) {
+                    Inner* inner = static_cast<Inner*>(child.get());
+                    inner->prefix = node4->prefix + static_cast<char>(node4->keys[0]) + inner->prefix;
+                }
+                slot = std::move(child);
+            }
+            return;
+        }
+        case NodeType::Node16: {
+            Node16* node16 = static_cast<Node16*>(node);
+            if (node16->childrenCount > 3) {
+                return;
+            }
+            NodePtr shrunk = moveInner<Node4>(node16);
+            Node4* node4 = static_cast<Node4*>(shrunk.get());
+            for (size_t i = 0; i < node16->childrenCount; ++i) {
+                node4->keys[i] = node16->keys[i];
+                node4->children[i] = std::move(node16->children[i]);
+            }
+            node4->childrenCount = node16->childrenCount;
+            slot = std::move(shrunk);
+            return;
+        }
+        case NodeType::Node48: {
+            Node48* node48 = static_cast<Node48*>(node);
+            if (node48->childrenCount > 12) {
+                return;
+            }
+            NodePtr shrunk = moveInner<Node16>(node48);
+            Node16* node16 = static_cast<Node16*>(shrunk.get());
+            for (size_t b = 0; b < 256; ++b) {
+                if (node48->index[b] != Node48::kEmpty) {
+                    node16->keys[node16->childrenCount] = static_cast<uint8_t>(b);
+                    node16->children[node16->childrenCount++] = std::move(node48->children[node48->index[b]]);
+                }
+            }
+            slot = std::move(shrunk);
+            return;
+        }
+        default: {
+            Node256* node256 = static_cast<Node256*>(node);
+            if (node256->childrenCount > 37) {
+                return;
+            }
+            NodePtr shrunk = moveInner<Node48>(node256);
+            Node48* node48 = static_cast<Node48*>(shrunk.get());
+            for (size_t b = 0; b < 256; ++b) {
+                if (node256->children[b]) {
+                    node48->index[b] = static_cast<uint8_t>(node48->childrenCount);
+                    node48->children[node48->childrenCount++] = std::move(node256->children[b]);
+                }
+            }
+            slot = std::move(shrunk);
+            return;
+        }
+    }
+}
+
+template <typename T>
+auto RadixTree<T>::firstChild(const Inner* node) -> const Node* {
+    switch (node->type) {
+        case NodeType::Node4: return static_cast<const Node4*>(node)->children[0].get();
+        case NodeType::Node16: return static_cast<const Node16*>(node)->children[0].get();
+        case NodeType::Node48: {
+            const Node48* node48 = static_cast<const Node48*>(node);
+            for (size_t b = 0; b < 256; ++b) {
+                if (node48->index[b] != Node48::kEmpty) return node48->children[node48->index[b]].get();
+            }
+            return nullptr;
+        }
+        default: {
+            const Node256* node256 = static_cast<const Node256*>(node);
+            for (size_t b = 0; b < 256; ++b) {
+                if (node256->children[b]) return node256->children[b].get();
+            }
+            return nullptr;
+        }
+    }
+}
+
+template <typename T>
+auto RadixTree<T>::lastChild(const Inner* node) -> const Node* {
+    if (node->childrenCount == 0) {
+        return nullptr;
+    }
+    switch (node->type) {
+        case NodeType::Node4: return static_cast<const Node4*>(node)->children[node->childrenCount - 1].get();
+        case NodeType::Node16: return static_cast<const Node16*>(node)->children[node->childrenCount - 1].get();
+        case NodeType::Node48: {
+            const Node48* node48 = static_cast<const Node48*>(node);
+            for (size_t b = 256; b-- > 0;) {
+                if (node48->index[b] != Node48::kEmpty) return node48->children[node48->index[b]].get();
+            }
+            return nullptr;
+        }
+        default: {
+            const Node256* node256 = static_cast<const Node256*>(node);
+            for (size_t b = 256; b-- > 0;) {
+                if (node256->children[b]) return node256->children[b].get();
+            }
+            return nullptr;
+        }
+    }
+}
+
+template <typename T>
+template <typename Visitor>
+void RadixTree<T>::forEachChild(const Inner* node, Visitor visit) {
+    switch (node->type) {
+        case NodeType::Node4: {
+            const Node4* node4 = static_cast<const Node4*>(node);
+            for (size_t i = 0; i < node4->childrenCount; ++i) visit(node4->children[i].get());
+            return;
+        }
+        case NodeType::Node16: {
+            const Node16* node16 = static_cast<const Node16*>(node);
+            for (size_t i = 0; i < node16->childrenCount; ++i) visit(node16->children[i].get());
+            return;
+        }
+        case NodeType::Node48: {
+            const Node48* node48 = static_cast<const Node48*>(node);
+            for (size_t b = 0; b < 256; ++b) {
+                if (node48->index[b] != Node48::kEmpty) visit(node48->children[node48->index[b]].get());
+            }
+            return;
+        }
+        default: {
+            const Node256* node256 = static_cast<const Node256*>(node);
+            for (size_t b = 0; b < 256; ++b) {
+                if (node256->children[b]) visit(node256->children[b].get());
+            }
+            return;
+        }
+    }
+}
+
+template <typename T>
+size_t RadixTree<T>::matchPrefix(const Inner* node, const Bytes& bytes, size_t depth) {
+    size_t limit = std::min(node->prefix.size(), bytes.size() - depth);
+    size_t matched = 0;
+    while (matched < limit && static_cast<uint8_t>(node->prefix[matched]) == byteAt(bytes, depth + matched)) {
+        matched++;
+    }
+    return matched;
+}
+
+template <typename T>
+void RadixTree<T>::insert(T data, uint64_t count) {
+    if (count == 0) {
+        return;
+    }
+    if (count > std::numeric_limits<size_t>::max() - m_elementsCount) {
+        throw std::overflow_error("Count overflow");
+    }
+    Bytes bytes = RadixKey<T>::encode(data);
+    recursive_insert(m_root, bytes, 0, data, count);
+    m_elementsCount += count;
+}
+
+template <typename T>
+void RadixTree<T>::recursive_insert(NodePtr& slot, const Bytes& bytes, size_t depth, T& data, uint64_t count) {
+    if (!slot) {
+        slot = makeLeaf(std::move(data), count);
+        m_nodesCount++;
+        return;
+    }
+
+    if (slot->type == NodeType::Leaf) {
+        Leaf* leaf = static_cast<Leaf*>(slot.get());
+        if (leaf->data == data) {
+            addCount(leaf->count, count);
+            return;
+        }
+        // Split at the first byte the two keys differ in, one of them may end there
+        Bytes existing = RadixKey<T>::encode(leaf->data);
+        size_t common = depth;
+        while (common < existing.size() && common < bytes.size() && byteAt(existing, common) == byteAt(bytes, common)) {
+            common++;
+        }
+        NodePtr split(new Node4());
+        Node4* node4 = static_cast<Node4*>(split.get());
+        for (size_t i = depth; i < common; ++i) {
+            node4->prefix.push_back(static_cast<char>(byteAt(bytes, i)));
+        }
+        if (common == existing.size()) {
+            node4->terminal = std::move(slot);
+        } else {
+            node4->add(byteAt(existing, common), std::move(slot));
+        }
+        if (common == bytes.size()) {
+            node4->terminal = makeLeaf(std::move(data), count);
+        } else {
+            uint8_t next = byteAt(bytes, common);
+            node4->add(next, makeLeaf(std::move(data), count));
+        }
+        slot = std::move(split);
+        m_nodesCount++;
+        return;
+    }
+
+    Inner* node = static_cast<Inner*>(slot.get());
+    size_t matched = matchPrefix(node, bytes, depth);
+    if (matched < node->prefix.size()) {
+        // The key leaves the compressed path, split it above this node
+        NodePtr split(new Node4());
+        Node4* node4 = static_cast<Node4*>(split.get());
+        node4->prefix = node->prefix.substr(0, matched);
+        uint8_t byte = static_cast<uint8_t>(node->prefix[matched]);
+        node->prefix.erase(0, matched + 1);
+        node4->add(byte, std::move(slot));
+        if (depth + matched == bytes.size()) {
+            node4->terminal = makeLeaf(std::move(data), count);
+        } else {
+            uint8_t next = byteAt(bytes, depth + matched);
+            node4->add(next, makeLeaf(std::move(data), count));
+        }
+        slot = std::move(split);
+        m_nodesCount++;
+        return;
+    }
+
+    depth += node->prefix.size();
+    if (depth == bytes.size()) {
+        if (node->terminal) {
+            addCount(static_cast<Leaf*>(node->terminal.get())->count, count);
+        } else {
+            node->terminal = makeLeaf(std::move(data), count);
+            m_nodesCount++;
+        }
+        return;
+    }
+
+    uint8_t next = byteAt(bytes, depth);
+    NodePtr* child = findChild(node, next);
+    if (child) {
+        recursive_insert(*child, bytes, depth + 1, data, count);
+        return;
+    }
+    addChild(slot, next, makeLeaf(std::move(data), count));
+    m_nodesCount++;
+}
+
+template <typename T>
+uint64_t RadixTree<T>::remove(const T& data, uint64_t count) {
+    Bytes bytes = RadixKey<T>::encode(data);
+    uint64_t removed = recursive_remove(m_root, bytes, 0, count);
+    m_elementsCount -= removed;
+    return removed;
+}
+
+template <typename T>
+uint64_t RadixTree<T>::recursive_remove(NodePtr& slot, const Bytes& bytes, size_t depth, uint64_t count) {
+    if (!slot) {
+        // Record not found
+        return 0;
+    }
+
+    if (slot->type == NodeType::Leaf) {
+        Leaf* leaf = static_cast<Leaf*>(slot.get());
+        if (RadixKey<T>::encode(leaf->data) != bytes) {
+            return 0;
+        }
+        uint64_t removed = std::min(count, leaf->count);
+        leaf->count -= removed;
+        if (leaf->count == 0) {
+            slot.reset();
+            m_nodesCount--;
+        }
+        return removed;
+    }
+
+    Inner* node = static_cast<Inner*>(slot.get());
+    if (matchPrefix(node, bytes, depth) < node->prefix.size()) {
+        return 0;
+    }
+    depth += node->prefix.size();
+
+    if (depth == bytes.size()) {
+        uint64_t removed = recursive_remove(node->terminal, bytes, depth, count);
+        if (!node->terminal) {
+            shrink(slot);
+        }
+        return removed;
+    }
+
+    uint8_t byte = byteAt(bytes, depth);
+    NodePtr* child = findChild(node, byte);
+    if (!child) {
+        return 0;
+    }
+    uint64_t removed = recursive_remove(*child, bytes, depth + 1, count);
+    if (!*child) {
+        removeChild(slot, byte);
+    }
+    return removed;
+}
+
+template <typename T>
+std::pair<T, uint64_t> RadixTree<T>::removeMin(uint64_t count) {
+    return removeExtreme(min(), count);
+}
+
+template <typename T>
+std::pair<T, uint64_t> RadixTree<T>::removeMax(uint64_t count) {
+    return removeExtreme(max(), count);
+}
+
+template <typename T>
+std::pair<T, uint64_t> RadixTree<T>::removeExtreme(const T& extreme, uint64_t count) {
+    // The leaf may be freed by the removal, keep a copy of its key
+    T outData = extreme;
+    uint64_t removed = remove(outData, count);
+    return {std::move(outData), removed};
+}
+
+template <typename T>
+uint64_t RadixTree<T>::count(const T& data) const {
+    Bytes bytes = RadixKey<T>::encode(data);
+    const Node* node = m_root.get();
+    size_t depth = 0;
+    while (node) {
+        if (node->type == NodeType::Leaf) {
+            const Leaf* leaf = static_cast<const Leaf*>(node);
+            return leaf->data == data ? leaf->count : 0;
+        }
+        const Inner* inner = static_cast<const Inner*>(node);
+        if (matchPrefix(inner, bytes, depth) < inner->prefix.size()) {
+            return 0;
+        }
+        depth += inner->prefix.size();
+        if (depth == bytes.size()) {
+            node = inner->terminal.get();
+            continue;
+        }
+        node = childAt(inner, byteAt(bytes, depth));
+        depth++;
+    }
+    return 0;
+}
+
+template <typename T>
+const T& RadixTree<T>::min() const {
+    if (!m_root) {
+        throw std::runtime_error("Tree is empty");
+    }
+    const Node* node = m_root.get();
+    while (node->type != NodeType::Leaf) {
+        const Inner* inner = static_cast<const Inner*>(node);
+        // A key ending here is a prefix of every key below
+        node = inner->terminal ? inner->terminal.get() : firstChild(inner);
+    }
+    return static_cast<const Leaf*>(node)->data;
+}
+
+template <typename T>
+const T& RadixTree<T>::max() const {
+    if (!m_root) {
+        throw std::runtime_error("Tree is empty");
+    }
+    const Node* node = m_root.get();
+    while (node->type != NodeType::Leaf) {
+        const Inner* inner = static_cast<const Inner*>(node);
+        const Node* last = lastChild(inner);
+        node = last ? last : inner->terminal.get();
+    }
+    return static_cast<const Leaf*>(node)->data;
+}
+
+template <typename T>
+template <typename Visitor>
+void RadixTree<T>::forEach(Visitor visit) const {
+    forEachDistinct([&visit](const T& data, uint64_t count) {
+        for (uint64_t i = 0; i < count; ++i) {
+            visit(data);
+        }
+    });
+}
+
+template <typename T>
+template <typename Visitor>
+void RadixTree<T>::forEachDistinct(Visitor visit) const {
+    if (m_root) {
+        recursive_for_each(m_root.get(), visit);
+    }
+}
+
+template <typename T>
+template <typename Visitor>
+void RadixTree<T>::recursive_for_each(const Node* node, Visitor& visit) {
+    // Depth is bounded by the key length, not by the number of keys
+    if (node->type == NodeType::Leaf) {
+        const Leaf* leaf = static_cast<const Leaf*>(node);
+        visit(leaf->data, leaf->count);
+        return;
+    }
+    const Inner* inner = static_cast<const Inner*>(node);
+    if (inner->terminal) {
+        recursive_for_each(inner->terminal.get(), visit);
+    }
+    forEachChild(inner, [&visit](const Node* child) { recursive_for_each(child, visit); });
+}
+
+} // namespace adsc
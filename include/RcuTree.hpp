@@ -0,0 +1,142 @@
+#pragma once
+
+#include "AVLTree.hpp"
+#include "EpochReclaimer.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace adsc {
+
+// Read-mostly AVLTree published through an atomic pointer (RCU style). A published
+// version is never modified: readers pin an EpochReclaimer, load the current version
+// and run its const members without any lock. A writer copies the current version,
+// applies its changes to the copy and swaps the pointer. The replaced version is
+// retired and freed after a grace period, once every reader pinned before the swap
+// has left.
+//
+// Every write copies the whole tree node by node, O(n); batch the changes with update()
+// when the set is rewritten now and then and read all the time. Writers are serialized.
+// T must be copyable.
+template <typename T, typename Comparator = std::less<T>>
+class RcuTree {
+public:
+    using value_type = T;
+    using comparator_type = Comparator;
+    using Tree = AVLTree<T, Comparator>;
+
+    explicit RcuTree(Comparator comp = Comparator());
+    ~RcuTree();
+
+    RcuTree(const RcuTree&) = delete;
+    RcuTree& operator=(const RcuTree&) = delete;
+
+    // Calls mutate(Tree&) on a copy of the current version and publishes the copy. If
+    // mutate throws nothing is published. Returns what mutate returns
+    template <typename Mutator>
+    auto update(Mutator mutate);
+    // Publishes a tree built elsewhere, the whole set at once
+    void replace(std::unique_ptr<Tree> tree);
+
+    // Single changes, one version each
+    void insert(T data) { update([&](Tree& tree) { tree.insert(std::move(data)); }); };
+    void remove(const T& data) { update([&](Tree& tree) { tree.remove(data); }); };
+    T removeMin() { return update([](Tree& tree) { return tree.removeMin(); }); };
+    T removeMax() { return update([](Tree& tree) { return tree.removeMax(); }); };
+
+    // Calls reader(const Tree&) on the current version and returns its result, every
+    // lookup of one call sees the same version. The reader must not write to this RcuTree
+    template <typename Reader>
+    auto read(Reader reader) const;
+
+    bool search(const T& data) const { return read([&](const Tree& tree) { return tree.search(data); }); };
+    uint64_t count(const T& data) const { return read([&](const Tree& tree) { return tree.count(data); }); };
+    T min() const { return read([](const Tree& tree) { return tree.min(); }); };
+    T max() const { return read([](const Tree& tree) { return tree.max(); }); };
+
+    template <typename Visitor>
+    void forEach(Visitor visit) const { read([&](const Tree& tree) { tree.forEach(visit); }); }
+
+    size_t nodesCount() const { return read([](const Tree& tree) { return tree.nodesCount(); }); };
+    size_t elementsCount() const { return read([](const Tree& tree) { return tree.elementsCount(); }); };
+    bool empty() const { return elementsCount() == 0; };
+
+    // Versions published so far, the initial empty one included
+    uint64_t versionsCount() const { return m_versions.load(std::memory_order_relaxed); };
+
+private:
+    // Helper for writers, the caller holds m_writerMutex
+    void publish(std::unique_ptr<Tree> tree);
+
+    std::atomic<Tree*> m_current;
+    std::atomic<uint64_t> m_versions{1};
+
+    std::mutex m_writerMutex;
+    mutable EpochReclaimer m_reclaimer;
+};
+
+template <typename T, typename Comparator>
+RcuTree<T, Comparator>::RcuTree(Comparator comp)
+: m_current(new Tree(std::move(comp)))
+{}
+
+template <typename T, typename Comparator>
+RcuTree<T, Comparator>::~RcuTree() {
+    // Retired versions are freed by the reclaimer
+    delete m_current.load();
+}
+
+template <typename T, typename Comparator>
+template <typename Mutator>
+auto RcuTree<T, Comparator>::update(Mutator mutate) {
+    std::lock_guard<std::mutex> lock(m_writerMutex);
+
+    // Only writers replace the version, under the lock it cannot be retired
+    const Tree* current = m_current.load(std::memory_order_relaxed);
+    auto copy = std::make_unique<Tree>(*current);
+
+    if constexpr (std::is_void_v<decltype(mutate(*copy))>) {
+        mutate(*copy);
+        publish(std::move(copy));
+    } else {
+        auto result = mutate(*copy);
+        publish(std::move(copy));
+        return result;
+    }
+}
+
+template <typename T, typename Comparator>
+void RcuTree<T, Comparator>::replace(std::unique_ptr<Tree> tree) {
+    if (!tree) {
+        throw std::invalid_argument("RcuTree cannot publish a null tree");
+    }
+    std::lock_guard<std::mutex> lock(m_writerMutex);
+    publish(std::move(tree));
+}
+
+template <typename T, typename Comparator>
+void RcuTree<T, Comparator>::publish(std::unique_ptr<Tree> tree) {
+    // Release: a reader that loads the new version sees it fully built
+    Tree* replaced = m_current.exchange(tree.release(), std::memory_order_acq_rel);
+    m_versions.fetch_add(1, std::memory_order_relaxed);
+
+    // A version is a whole tree, free the old ones on every write rather than in batches
+    auto guard = m_reclaimer.pin();
+    guard.retire(replaced);
+    guard.reclaim();
+}
+
+template <typename T, typename Comparator>
+template <typename Reader>
+auto RcuTree<T, Comparator>::read(Reader reader) const {
+    auto guard = m_reclaimer.pin();
+    return reader(*m_current.load(std::memory_order_acquire));
+}
+
+} // namespace adsc
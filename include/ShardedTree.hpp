@@ -0,0 +1,312 @@
+#pragma once
+
+#include "AVLTree.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace adsc {
+
+// Range partitioned AVLTree for concurrent writers. Splitter keys cut the key space
+// into shards with a lock each, point operations only lock the shard owning the key.
+// A shared layout lock is held by every operation and taken exclusively to move the
+// splitters, which happens when inserts skew the shards (or on rebalanceShards()).
+//
+// removeMin/removeMax take from the first/last non-empty shard. Under concurrent
+// inserts into an earlier shard they return that shard's extreme, not a global one.
+template <typename T, typename Comparator = std::less<T>>
+class ShardedTree {
+public:
+    using value_type = T;
+    using comparator_type = Comparator;
+
+    explicit ShardedTree(size_t shards = 16, Comparator comp = Comparator());
+
+    ShardedTree(const ShardedTree&) = delete;
+    ShardedTree& operator=(const ShardedTree&) = delete;
+
+    void insert(T data);
+    void remove(const T& data);
+    T removeMin();
+    T removeMax();
+
+    bool search(const T& data) const;
+
+    // Visits every element in order, shard after shard
+    template <typename Visitor>
+    void forEach(Visitor visit) const;
+
+    // Exact once the tree is quiescent. Like every reader they hold the layout lock,
+    // a rebalance frees the shards it replaces
+    size_t nodesCount() const;
+    size_t elementsCount() const;
+    bool empty() const { return elementsCount() == 0; };
+
+    size_t shardsCount() const;
+    std::vector<size_t> shardSizes() const;
+
+    // Picks new splitters at the element quantiles and redistributes every shard, O(n log n).
+    // The old shards are kept until the new ones are complete
+    void rebalanceShards();
+
+    // Automatic rebalancing on skew, enabled by default
+    void setAutoRebalance(bool enabled) { m_autoRebalance = enabled; };
+
+private:
+    using Tree = AVLTree<T, Comparator>;
+
+    struct alignas(64) Shard {
+        explicit Shard(const Comparator& comp) : tree(comp) {}
+
+        // Mirrors of the tree counters, readable without the lock
+        void publish() {
+            elements.store(tree.elementsCount(), std::memory_order_relaxed);
+            nodes.store(tree.nodesCount(), std::memory_order_relaxed);
+        }
+
+        mutable std::mutex mutex;
+        Tree tree;
+        std::atomic<size_t> elements{0};
+        std::atomic<size_t> nodes{0};
+        // Inserts since the last rebalance, only written under the lock
+        std::atomic<size_t> inserted{0};
+    };
+
+    // Skew is checked every kCheckInterval inserts into a shard
+    static constexpr size_t kCheckInterval = 1024;
+    static constexpr size_t kMinShardSlack = 64;
+
+    size_t shardFor(const T& data) const;
+
+    // Helpers for automatic rebalancing
+    bool isSkewed() const;
+    void rebalanceIfSkewed();
+    void redistribute();
+
+    template <typename Take>
+    T takeExtreme(bool fromFront, Take take);
+
+    mutable std::shared_mutex m_layout;
+    // Shard i holds the keys k with splitters[i - 1] <= k < splitters[i]
+    std::vector<T> m_splitters;
+    std::vector<std::unique_ptr<Shard>> m_shards;
+    Comparator m_comparator;
+
+    std::atomic<size_t> m_elementsAtRebalance{0};
+    std::atomic<bool> m_autoRebalance{true};
+};
+
+template <typename T, typename Comparator>
+ShardedTree<T, Comparator>::ShardedTree(size_t shards, Comparator comp)
+: m_comparator(std::move(comp))
+{
+    if (shards == 0) {
+        throw std::invalid_argument("ShardedTree needs at least one shard");
+    }
+    for (size_t i = 0; i < shards; ++i) {
+        m_shards.push_back(std::make_unique<Shard>(m_comparator));
+    }
+}
+
+template <typename T, typename Comparator>
+size_t ShardedTree<T, Comparator>::shardFor(const T& data) const {
+    return std::upper_bound(m_splitters.begin(), m_splitters.end(), data, m_comparator) - m_splitters.begin();
+}
+
+template <typename T, typename Comparator>
+void ShardedTree<T, Comparator>::insert(T data) {
+    bool check = false;
+    {
+        std::shared_lock<std::shared_mutex> layout(m_layout);
+        Shard& shard = *m_shards[shardFor(data)];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.tree.insert(std::move(data));
+        shard.publish();
+
+        size_t inserted = shard.inserted.load(std::memory_order_relaxed) + 1;
+        shard.inserted.store(inserted, std::memory_order_relaxed);
+        // Under the layout lock, a rebalance replaces the shards
+        check = inserted % kCheckInterval == 0 && m_autoRebalance.load(std::memory_order_relaxed) && isSkewed();
+    }
+    if (check) {
+        rebalanceIfSkewed();
+    }
+}
+
+template <typename T, typename Comparator>
+void ShardedTree<T, Comparator>::remove(const T& data) {
+    std::shared_lock<std::shared_mutex> layout(m_layout);
+    Shard& shard = *m_shards[shardFor(data)];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.tree.remove(data);
+    shard.publish();
+}
+
+template <typename T, typename Comparator>
+bool ShardedTree<T, Comparator>::search(const T& data) const {
+    std::shared_lock<std::shared_mutex> layout(m_layout);
+    const Shard& shard = *m_shards[shardFor(data)];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    return shard.tree.search(data);
+}
+
+template <typename T, typename Comparator>
+T ShardedTree<T, Comparator>::removeMin() {
+    return takeExtreme(true, [](Tree& tree) { return tree.removeMin(); });
+}
+
+template <typename T, typename Comparator>
+T ShardedTree<T, Comparator>::removeMax() {
+    return takeExtreme(false, [](Tree& tree) { return tree.removeMax(); });
+}
+
+template <typename T, typename Comparator>
+template <typename Take>
+T ShardedTree<T, Comparator>::takeExtreme(bool fromFront, Take take) {
+    std::shared_lock<std::shared_mutex> layout(m_layout);
+    // Shards are ordered, the extreme sits in the first non-empty one
+    for (size_t i = 0; i < m_shards.size(); ++i) {
+        Shard& shard = *m_shards[fromFront ? i : m_shards.size() - 1 - i];
+        if (shard.elements.load(std::memory_order_relaxed) == 0) {
+            continue;
+        }
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        if (shard.tree.empty()) {
+            continue;
+        }
+        T outData = take(shard.tree);
+        shard.publish();
+        return outData;
+    }
+    throw std::runtime_error("Tree is empty");
+}
+
+template <typename T, typename Comparator>
+template <typename Visitor>
+void ShardedTree<T, Comparator>::forEach(Visitor visit) const {
+    std::shared_lock<std::shared_mutex> layout(m_layout);
+    for (const auto& shard : m_shards) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        shard->tree.forEach(visit);
+    }
+}
+
+template <typename T, typename Comparator>
+size_t ShardedTree<T, Comparator>::nodesCount() const {
+    std::shared_lock<std::shared_mutex> layout(m_layout);
+    size_t count = 0;
+    for (const auto& shard : m_shards) count += shard->nodes.load(std::memory_order_relaxed);
+    return count;
+}
+
+template <typename T, typename Comparator>
+size_t ShardedTree<T, Comparator>::elementsCount() const {
+    std::shared_lock<std::shared_mutex> layout(m_layout);
+    size_t count = 0;
+    for (const auto& shard : m_shards) count += shard->elements.load(std::memory_order_relaxed);
+    return count;
+}
+
+template <typename T, typename Comparator>
+size_t ShardedTree<T, Comparator>::shardsCount() const {
+    std::shared_lock<std::shared_mutex> layout(m_layout);
+    return m_shards.size();
+}
+
+template <typename T, typename Comparator>
+std::vector<size_t> ShardedTree<T, Comparator>::shardSizes() const {
+    std::shared_lock<std::shared_mutex> layout(m_layout);
+    std::vector<size_t> sizes;
+    for (const auto& shard : m_shards) sizes.push_back(shard->elements.load(std::memory_order_relaxed));
+    return sizes;
+}
+
+template <typename T, typename Comparator>
+bool ShardedTree<T, Comparator>::isSkewed() const {
+    size_t total = 0;
+    size_t largest = 0;
+    size_t inserted = 0;
+    for (const auto& shard : m_shards) {
+        size_t elements = shard->elements.load(std::memory_order_relaxed);
+        total += elements;
+        largest = std::max(largest, elements);
+        inserted += shard->inserted.load(std::memory_order_relaxed);
+    }
+    // Rebalancing is O(n), paying for it takes as many inserts as half the tree
+    // had at the previous rebalance
+    return largest > 2 * (total / m_shards.size()) + kMinShardSlack &&
+           inserted >= m_elementsAtRebalance.load(std::memory_order_relaxed) / 2;
+}
+
+template <typename T, typename Comparator>
+void ShardedTree<T, Comparator>::rebalanceIfSkewed() {
+    std::unique_lock<std::shared_mutex> layout(m_layout);
+    // Another writer may have rebalanced in between
+    if (isSkewed()) {
+        redistribute();
+    }
+}
+
+template <typename T, typename Comparator>
+void ShardedTree<T, Comparator>::rebalanceShards() {
+    std::unique_lock<std::shared_mutex> layout(m_layout);
+    redistribute();
+}
+
+template <typename T, typename Comparator>
+void ShardedTree<T, Comparator>::redistribute() {
+    // Exclusive layout lock held, no operation is inside a shard. The new shards are
+    // built next to the old ones and swapped in once complete, a throw changes nothing
+    std::vector<std::pair<T, uint64_t>> runs;
+    uint64_t total = 0;
+    for (const auto& shard : m_shards) {
+        shard->tree.forEachDistinct([&](const T& data, uint64_t count) {
+            runs.emplace_back(data, count);
+            total += count;
+        });
+    }
+
+    // Runs come out sorted, a splitter starts every further 1/K of the elements
+    const size_t shards = m_shards.size();
+    std::vector<T> splitters;
+    uint64_t seen = 0;
+    size_t next = 1;
+    for (const auto& run : runs) {
+        while (next < shards && seen >= next * total / shards) {
+            if (seen > 0 && (splitters.empty() || m_comparator(splitters.back(), run.first))) {
+                splitters.push_back(run.first);
+            }
+            next++;
+        }
+        seen += run.second;
+    }
+
+    std::vector<std::unique_ptr<Shard>> rebuilt;
+    for (size_t i = 0; i < shards; ++i) {
+        rebuilt.push_back(std::make_unique<Shard>(m_comparator));
+    }
+    size_t target = 0;
+    for (auto& run : runs) {
+        while (target < splitters.size() && !m_comparator(run.first, splitters[target])) {
+            target++;
+        }
+        rebuilt[target]->tree.insert(std::move(run.first), run.second);
+    }
+    for (auto& shard : rebuilt) {
+        shard->publish();
+    }
+
+    m_splitters.swap(splitters);
+    m_shards.swap(rebuilt);
+    m_elementsAtRebalance.store(total, std::memory_order_relaxed);
+}
+
+} // namespace adsc
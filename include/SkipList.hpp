@@ -0,0 +1,248 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace adsc {
+
+template <typename T, typename Comparator = std::less<T>>
+class SkipList {
+public:
+    using value_type = T;
+    using comparator_type = Comparator;
+
+    static constexpr uint32_t kMaxLevel = 32;
+
+    explicit SkipList(Comparator comp = Comparator());
+    ~SkipList();
+
+    SkipList(const SkipList&) = delete;
+    SkipList& operator=(const SkipList&) = delete;
+
+    void insert(T data);
+    void remove(const T& data);
+    T removeMin();
+    T removeMax();
+
+    bool search(const T& data) const;
+
+    size_t nodesCount() const { return m_nodesCount; };
+    size_t elementsCount() const { return m_elementsCount; };
+
+    bool empty() const { return m_head[0] == nullptr; };
+
+    uint32_t getLevel() const { return m_level; };
+
+private:
+    struct Node {
+        Node(T value, uint32_t level) : data(std::move(value)), count(1), next(level, nullptr) {}
+
+        const T data;
+        uint64_t count;
+        std::vector<Node*> next;
+    };
+
+    // Each entry points at the link (head slot or node->next[i]) preceding the target
+    using Links = std::array<Node**, kMaxLevel>;
+
+    // Helper for insert/remove, fills the links preceding the first node >= data
+    Node* findPredecessors(const T& data, Links& update);
+
+    // Helper for removeMin/removeMax, unlinks a node and frees it
+    void unlink(Node* node, Links& update);
+
+    uint32_t randomLevel();
+
+    bool equal(const T& a, const T& b) const {
+        return !m_comparator(a, b) && !m_comparator(b, a);
+    }
+
+    // Nodes are owned by the list through the level 0 chain
+    std::array<Node*, kMaxLevel> m_head{};
+    uint32_t m_level{1};
+
+    Comparator m_comparator;
+    uint64_t m_randomState{0x9E3779B97F4A7C15ull};
+
+    size_t m_nodesCount{0};
+    size_t m_elementsCount{0};
+};
+
+template <typename T, typename Comparator>
+SkipList<T, Comparator>::SkipList(Comparator comp)
+: m_comparator(std::move(comp))
+{}
+
+template <typename T, typename Comparator>
+SkipList<T, Comparator>::~SkipList() {
+    Node* node = m_head[0];
+    while (node) {
+        Node* next = node->next[0];
+        delete node;
+        node = next;
+    }
+}
+
+template <typename T, typename Comparator>
+uint32_t SkipList<T, Comparator>::randomLevel() {
+    // xorshift64, every level is promoted with probability 1/4
+    m_randomState ^= m_randomState << 13;
+    m_randomState ^= m_randomState >> 7;
+    m_randomState ^= m_randomState << 17;
+
+    uint64_t bits = m_randomState;
+    uint32_t level = 1;
+    while (level < kMaxLevel && (bits & 3) == 0) {
+        level++;
+        bits >>= 2;
+    }
+    return level;
+}
+
+template <typename T, typename Comparator>
+typename SkipList<T, Comparator>::Node*
+SkipList<T, Comparator>::findPredecessors(const T& data, Links& update) {
+    Node* pred = nullptr;
+    for (uint32_t i = m_level; i-- > 0;) {
+        Node** link = pred ? &pred->next[i] : &m_head[i];
+        while (*link && m_comparator((*link)->data, data)) {
+            pred = *link;
+            link = &pred->next[i];
+        }
+        update[i] = link;
+    }
+    return *update[0];
+}
+
+template <typename T, typename Comparator>
+void SkipList<T, Comparator>::insert(T data) {
+    Links update{};
+    Node* node = findPredecessors(data, update);
+
+    if (node && equal(node->data, data)) {
+        if (node->count == std::numeric_limits<uint64_t>::max()) {
+            throw std::overflow_error("Count overflow");
+        }
+        node->count++;
+        this->m_elementsCount++;
+        return;
+    }
+
+    uint32_t level = randomLevel();
+    if (level > m_level) {
+        for (uint32_t i = m_level; i < level; ++i) {
+            update[i] = &m_head[i];
+        }
+        m_level = level;
+    }
+
+    Node* created = new Node(std::move(data), level);
+    for (uint32_t i = 0; i < level; ++i) {
+        created->next[i] = *update[i];
+        *update[i] = created;
+    }
+    this->m_elementsCount++;
+    this->m_nodesCount++;
+}
+
+template <typename T, typename Comparator>
+void SkipList<T, Comparator>::remove(const T& data) {
+    Links update{};
+    Node* node = findPredecessors(data, update);
+    if (!node || !equal(node->data, data)) {
+        // Record not found
+        return;
+    }
+
+    this->m_elementsCount--;
+    if (--node->count > 0) {
+        return;
+    }
+    unlink(node, update);
+}
+
+template <typename T, typename Comparator>
+void SkipList<T, Comparator>::unlink(Node* node, Links& update) {
+    for (uint32_t i = 0; i < node->next.size(); ++i) {
+        *update[i] = node->next[i];
+    }
+    while (m_level > 1 && m_head[m_level - 1] == nullptr) {
+        m_level--;
+    }
+    this->m_nodesCount--;
+    delete node;
+}
+
+template <typename T, typename Comparator>
+T SkipList<T, Comparator>::removeMin() {
+    if (this->empty()) {
+        throw std::runtime_error("List is empty");
+    }
+    this->m_elementsCount--;
+
+    Node* node = m_head[0];
+    T outData = node->data;
+    if (--node->count > 0) {
+        // Only decrement count
+        return outData;
+    }
+
+    // The first node is the first one on every level it spans
+    Links update{};
+    for (uint32_t i = 0; i < node->next.size(); ++i) {
+        update[i] = &m_head[i];
+    }
+    unlink(node, update);
+    return outData;
+}
+
+template <typename T, typename Comparator>
+T SkipList<T, Comparator>::removeMax() {
+    if (this->empty()) {
+        throw std::runtime_error("List is empty");
+    }
+    this->m_elementsCount--;
+
+    // Follow the rightmost path down to the last node
+    Node* last = nullptr;
+    for (uint32_t i = m_level; i-- > 0;) {
+        Node* next = last ? last->next[i] : m_head[i];
+        while (next) {
+            last = next;
+            next = last->next[i];
+        }
+    }
+
+    T outData = last->data;
+    if (--last->count > 0) {
+        // Only decrement count
+        return outData;
+    }
+
+    Links update{};
+    findPredecessors(last->data, update);
+    unlink(last, update);
+    return outData;
+}
+
+template <typename T, typename Comparator>
+bool SkipList<T, Comparator>::search(const T& data) const {
+    Node* pred = nullptr;
+    for (uint32_t i = m_level; i-- > 0;) {
+        Node* next = pred ? pred->next[i] : m_head[i];
+        while (next && m_comparator(next->data, data)) {
+            pred = next;
+            next = pred->next[i];
+        }
+        if (next && !m_comparator(data, next->data)) {
+            return true; // Found the element
+        }
+    }
+    return false;
+}
+
+} // namespace adsc
@@ -0,0 +1,416 @@
+#pragma once
+
+#include "BinaryTreeNode.hpp"
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace adsc {
+
+// Static (CRTP) base of the trees. Derived implements insert, remove, removeMin and
+// removeMax; everything here calls them through the concrete type, so generic code
+// over trees compiles to direct, inlinable calls. Wrap a tree in TreeAdapter
+// (BinarySortingTree.hpp) when a runtime-polymorphic interface is needed.
+template <typename Derived, typename T, typename Comparator = std::less<T>, typename Augmentation = NoAugmentation<T>,
+          typename Layout = DefaultNodeLayout>
+class SortedTree {
+public:
+    using value_type = T;
+    using comparator_type = Comparator;
+    using node_type = BinaryTreeNode<T, Augmentation, Layout>;
+
+    size_t nodesCount() const {return m_nodesCount;};
+    size_t elementsCount() const {return m_elementsCount;};
+
+    bool search(const T& data) const {
+        return searchRecursive(m_root, data);
+    }
+    // Number of stored copies of data, 0 if absent
+    uint64_t count(const T& data) const;
+
+    // Looks up every key of a batch, results[i] tells whether keys[i] is present.
+    // Interleaves kSearchLanes independent descents and prefetches the next node of
+    // each one, so the cache misses of a large tree overlap instead of queueing up
+    template <typename Keys, typename Results>
+    void searchBatch(const Keys& keys, Results& results) const;
+
+    // Visits every element in order, once per copy
+    template <typename Visitor>
+    void forEach(Visitor visit) const;
+    // Visits every distinct element in order as visit(data, count), skipping tombstones
+    template <typename Visitor>
+    void forEachDistinct(Visitor visit) const;
+
+    // Inserts every element of [first, last) through the derived insert
+    template <typename InputIt>
+    void insertAll(InputIt first, InputIt last);
+
+    bool empty() const;
+
+    // Smallest and largest element in O(1), throw on an empty tree
+    const T& min() const;
+    const T& max() const;
+
+    const std::unique_ptr<BinaryTreeNode<T, Augmentation, Layout>>& getRoot() const;
+    const Comparator& getComparator() const { return m_comparator; }
+
+    // Takes every node out of a tree and hands them out in order. Right rotations at
+    // the top replace the spine walks, so dismantling the whole tree is O(n)
+    class Drain {
+    public:
+        explicit Drain(SortedTree& tree) : m_node(tree.detachNodes()) { settle(); }
+
+        bool done() const { return !m_node; }
+        const T& front() const { return m_node->getData(); }
+        uint64_t frontCount() const { return m_node->getCount(); }
+        void pop();
+
+    private:
+        // Helper for pop, brings the next live node to the top
+        void settle();
+
+        std::unique_ptr<BinaryTreeNode<T, Augmentation, Layout>> m_node;
+    };
+
+    // Streams every element in order into out, copies expanded, leaving the tree empty. O(n)
+    template <typename OutputIt>
+    OutputIt drain(OutputIt out);
+    std::vector<T> extractAll();
+
+    // Frees every node without recursion
+    void clear();
+
+protected:
+    explicit SortedTree(Comparator comp = Comparator());
+    ~SortedTree() = default;
+
+    Derived& derived() { return static_cast<Derived&>(*this); }
+    const Derived& derived() const { return static_cast<const Derived&>(*this); }
+
+    static constexpr size_t kSearchLanes = 16;
+
+    static void prefetch(const BinaryTreeNode<T, Augmentation, Layout>* node) {
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(node);
+#else
+        (void)node;
+#endif
+    }
+
+    bool searchRecursive(const std::unique_ptr<BinaryTreeNode<T, Augmentation, Layout>>& node, const T& data) const;
+
+    // Helpers keeping the cached extremal nodes valid
+    void trackInserted(BinaryTreeNode<T, Augmentation, Layout>* node);
+    void refreshMin();
+    void refreshMax();
+    bool isEquivalent(const T& a, const T& b) const;
+
+    // Helper for insert, the total bounds every node count so checking it suffices
+    void addElements(uint64_t count);
+
+    // Helpers for Drain and clear, Derived may hide onClear to reset its own state
+    std::unique_ptr<BinaryTreeNode<T, Augmentation, Layout>> detachNodes();
+    void onClear() {}
+
+    std::unique_ptr<BinaryTreeNode<T, Augmentation, Layout>> m_root;
+    Comparator m_comparator;
+
+    // Leftmost and rightmost node, rotations move nodes but never reallocate them
+    BinaryTreeNode<T, Augmentation, Layout>* m_minNode{nullptr};
+    BinaryTreeNode<T, Augmentation, Layout>* m_maxNode{nullptr};
+
+    size_t m_nodesCount{0};
+    size_t m_elementsCount{0};
+};
+
+template <typename Derived, typename T, typename Comparator, typename Augmentation, typename Layout>
+SortedTree<Derived, T, Comparator, Augmentation, Layout>::SortedTree(Comparator comp)
+    : m_root(nullptr), m_comparator(std::move(comp)) {}
+
+
+template <typename Derived, typename T, typename Comparator, typename Augmentation, typename Layout>
+template <typename InputIt>
+void SortedTree<Derived, T, Comparator, Augmentation, Layout>::insertAll(InputIt first, InputIt last) {
+    for (; first != last; ++first) {
+        derived().insert(*first);
+    }
+}
+
+template <typename Derived, typename T, typename Comparator, typename Augmentation, typename Layout>
+template <typename Keys, typename Results>
+void SortedTree<Derived, T, Comparator, Augmentation, Layout>::searchBatch(const Keys& keys, Results& results) const {
+    struct Lane {
+        const BinaryTreeNode<T, Augmentation, Layout>* node;
+        size_t index;
+    };
+
+    const size_t count = keys.size();
+    results.resize(count);
+
+    // A lane that finishes its descent picks up the next key right away (AMAC)
+    std::array<Lane, kSearchLanes> lanes;
+    size_t active = 0;
+    size_t next = 0;
+    while (active < kSearchLanes && next < count) {
+        lanes[active++] = {m_root.get(), next++};
+    }
+
+    while (active > 0) {
+        for (size_t i = 0; i < active;) {
+            Lane& lane = lanes[i];
+            const BinaryTreeNode<T, Augmentation, Layout>* node = lane.node;
+            const T& key = keys[lane.index];
+
+            if (node && m_comparator(key, node->getData())) {
+                lane.node = node->getLeft().get();
+            } else if (node && m_comparator(node->getData(), key)) {
+                lane.node = node->getRight().get();
+            } else {
+                // Found the element unless it is a tombstone, or ran off the tree
+                results[lane.index] = node && node->getCount() > 0;
+                node = nullptr;
+            }
+            if (node) {
+                // One step down, the next visit of this lane finds the child in cache
+                prefetch(lane.node);
+                ++i;
+                continue;
+            }
+
+            // Descent finished, refill the lane or retire it
+            if (next < count) {
+                lane = {m_root.get(), next++};
+                ++i;
+            } else {
+                lane = lanes[--active];
+            }
+        }
+    }
+}
+
+template <typename Derived, typename T, typename Comparator, typename Augmentation, typename Layout>
+template <typename Visitor>
+void SortedTree<Derived, T, Comparator, Augmentation, Layout>::forEach(Visitor visit) const {
+    forEachDistinct([&visit](const T& data, uint64_t count) {
+        for (uint64_t i = 0; i < count; ++i) {
+            visit(data);
+        }
+    });
+}
+
+template <typename Derived, typename T, typename Comparator, typename Augmentation, typename Layout>
+template <typename Visitor>
+void SortedTree<Derived, T, Comparator, Augmentation, Layout>::forEachDistinct(Visitor visit) const {
+    // Explicit stack, unbalanced trees may be far too deep to recurse
+    std::vector<const BinaryTreeNode<T, Augmentation, Layout>*> path;
+    const BinaryTreeNode<T, Augmentation, Layout>* node = m_root.get();
+    while (node || !path.empty()) {
+        while (node) {
+            path.push_back(node);
+            node = node->getLeft().get();
+        }
+        node = path.back();
+        path.pop_back();
+        if (node->getCount() > 0) {
+            visit(node->getData(), node->getCount());
+        }
+        node = node->getRight().get();
+    }
+}
+
+template <typename Derived, typename T, typename Comparator, typename Augmentation, typename Layout>
+void SortedTree<Derived, T, Comparator, Augmentation, Layout>::Drain::pop() {
+    m_node = std::move(m_node->getRight());
+    settle();
+}
+
+template <typename Derived, typename T, typename Comparator, typename Augmentation, typename Layout>
+void SortedTree<Derived, T, Comparator, Augmentation, Layout>::Drain::settle() {
+    while (m_node) {
+        if (m_node->getLeft()) {
+            // Rotate right, the left child moves up
+            std::unique_ptr<BinaryTreeNode<T, Augmentation, Layout>> left = std::move(m_node->getLeft());
+            m_node->getLeft() = std::move(left->getRight());
+            left->getRight() = std::move(m_node);
+            m_node = std::move(left);
+        } else if (m_node->getCount() == 0) {
+            // Skip tombstones
+            m_node = std::move(m_node->getRight());
+        } else {
+            return;
+        }
+    }
+}
+
+template <typename Derived, typename T, typename Comparator, typename Augmentation, typename Layout>
+template <typename OutputIt>
+OutputIt SortedTree<Derived, T, Comparator, Augmentation, Layout>::drain(OutputIt out) {
+    for (Drain nodes(*this); !nodes.done(); nodes.pop()) {
+        for (uint64_t i = 0; i < nodes.frontCount(); ++i) {
+            *out++ = nodes.front();
+        }
+    }
+    return out;
+}
+
+template <typename Derived, typename T, typename Comparator, typename Augmentation, typename Layout>
+std::vector<T> SortedTree<Derived, T, Comparator, Augmentation, Layout>::extractAll() {
+    std::vector<T> elements;
+    elements.reserve(m_elementsCount);
+    drain(std::back_inserter(elements));
+    return elements;
+}
+
+template <typename Derived, typename T, typename Comparator, typename Augmentation, typename Layout>
+void SortedTree<Derived, T, Comparator, Augmentation, Layout>::clear() {
+    for (Drain nodes(*this); !nodes.done(); nodes.pop()) {
+    }
+}
+
+template <typename Derived, typename T, typename Comparator, typename Augmentation, typename Layout>
+std::unique_ptr<BinaryTreeNode<T, Augmentation, Layout>> SortedTree<Derived, T, Comparator, Augmentation, Layout>::detachNodes() {
+    m_minNode = nullptr;
+    m_maxNode = nullptr;
+    m_nodesCount = 0;
+    m_elementsCount = 0;
+    derived().onClear();
+    return std::move(m_root);
+}
+
+template <typename Derived, typename T, typename Comparator, typename Augmentation, typename Layout>
+bool SortedTree<Derived, T, Comparator, Augmentation, Layout>::empty() const {
+    return m_root == nullptr;
+}
+    
+template <typename Derived, typename T, typename Comparator, typename Augmentation, typename Layout>
+const T& SortedTree<Derived, T, Comparator, Augmentation, Layout>::min() const {
+    if (this->empty()) {
+        throw std::runtime_error("Tree is empty");
+    }
+    return m_minNode->getData();
+}
+
+template <typename Derived, typename T, typename Comparator, typename Augmentation, typename Layout>
+const T& SortedTree<Derived, T, Comparator, Augmentation, Layout>::max() const {
+    if (this->empty()) {
+        throw std::runtime_error("Tree is empty");
+    }
+    return m_maxNode->getData();
+}
+
+template <typename Derived, typename T, typename Comparator, typename Augmentation, typename Layout>
+const std::unique_ptr<BinaryTreeNode<T, Augmentation, Layout>>& SortedTree<Derived, T, Comparator, Augmentation, Layout>::getRoot() const {
+    return m_root;
+}
+
+template <typename Derived, typename T, typename Comparator, typename Augmentation, typename Layout>
+uint64_t SortedTree<Derived, T, Comparator, Augmentation, Layout>::count(const T& data) const {
+    const BinaryTreeNode<T, Augmentation, Layout>* node = m_root.get();
+    while (node) {
+        if (m_comparator(data, node->getData())) {
+            node = node->getLeft().get();
+        } else if (m_comparator(node->getData(), data)) {
+            node = node->getRight().get();
+        } else {
+            return node->getCount();
+        }
+    }
+    return 0;
+}
+
+template <typename Derived, typename T, typename Comparator, typename Augmentation, typename Layout>
+bool SortedTree<Derived, T, Comparator, Augmentation, Layout>::searchRecursive(const std::unique_ptr<BinaryTreeNode<T, Augmentation, Layout>>& node, const T& data) const {
+    if (!node) return false;
+
+    if (m_comparator(data, node->getData())) {
+        return searchRecursive(node->getLeft(), data);
+    } else if (m_comparator(node->getData(), data)) {
+        return searchRecursive(node->getRight(), data);
+    }
+    return node->getCount() > 0; // Found the element, unless it is a tombstone
+}
+
+template <typename Derived, typename T, typename Comparator, typename Augmentation, typename Layout>
+void SortedTree<Derived, T, Comparator, Augmentation, Layout>::trackInserted(BinaryTreeNode<T, Augmentation, Layout>* node) {
+    // Nodes equivalent to the maximum are placed to its right
+    if (!m_minNode || m_comparator(node->getData(), m_minNode->getData())) {
+        m_minNode = node;
+    }
+    if (!m_maxNode || !m_comparator(node->getData(), m_maxNode->getData())) {
+        m_maxNode = node;
+    }
+}
+
+template <typename Derived, typename T, typename Comparator, typename Augmentation, typename Layout>
+void SortedTree<Derived, T, Comparator, Augmentation, Layout>::refreshMin() {
+    BinaryTreeNode<T, Augmentation, Layout>* node = m_root.get();
+    while (node && node->getLeft()) {
+        node = node->getLeft().get();
+    }
+    m_minNode = node;
+}
+
+template <typename Derived, typename T, typename Comparator, typename Augmentation, typename Layout>
+void SortedTree<Derived, T, Comparator, Augmentation, Layout>::refreshMax() {
+    BinaryTreeNode<T, Augmentation, Layout>* node = m_root.get();
+    while (node && node->getRight()) {
+        node = node->getRight().get();
+    }
+    m_maxNode = node;
+}
+
+template <typename Derived, typename T, typename Comparator, typename Augmentation, typename Layout>
+bool SortedTree<Derived, T, Comparator, Augmentation, Layout>::isEquivalent(const T& a, const T& b) const {
+    return !m_comparator(a, b) && !m_comparator(b, a);
+}
+
+template <typename Derived, typename T, typename Comparator, typename Augmentation, typename Layout>
+void SortedTree<Derived, T, Comparator, Augmentation, Layout>::addElements(uint64_t count) {
+    if (count > std::numeric_limits<size_t>::max() - m_elementsCount) {
+        throw std::overflow_error("Count overflow");
+    }
+    m_elementsCount += count;
+}
+
+// Drains several trees into one ordered stream, O(n log k) for k trees. Every tree ends up empty
+template <typename Tree, typename OutputIt>
+OutputIt mergeDrain(const std::vector<Tree*>& trees, OutputIt out) {
+    if (trees.empty()) {
+        return out;
+    }
+
+    std::vector<typename Tree::Drain> cursors;
+    cursors.reserve(trees.size());
+    std::vector<size_t> heap;
+    for (Tree* tree : trees) {
+        cursors.emplace_back(*tree);
+        if (!cursors.back().done()) heap.push_back(cursors.size() - 1);
+    }
+
+    // Min-heap of cursor indices ordered by their front element
+    const auto& comparator = trees.front()->getComparator();
+    auto later = [&](size_t a, size_t b) { return comparator(cursors[b].front(), cursors[a].front()); };
+    std::make_heap(heap.begin(), heap.end(), later);
+
+    while (!heap.empty()) {
+        std::pop_heap(heap.begin(), heap.end(), later);
+        auto& cursor = cursors[heap.back()];
+        for (uint64_t i = 0; i < cursor.frontCount(); ++i) {
+            *out++ = cursor.front();
+        }
+        cursor.pop();
+        if (cursor.done()) {
+            heap.pop_back();
+        } else {
+            std::push_heap(heap.begin(), heap.end(), later);
+        }
+    }
+    return out;
+}
+
+} // namespace adsc
\ No newline at end of file
@@ -0,0 +1,190 @@
+#pragma once
+
+#include "AVLBalance.hpp"
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+namespace adsc {
+
+// Fixed capacity AVL tree stored in an array, with indices as child links.
+// Every operation is constexpr, so a lookup table known at compile time is built
+// by the compiler and lands in read-only data without a single allocation:
+//
+//     constexpr adsc::StaticAVLTree<int, 4> kPorts{80, 443, 8080, 8443};
+//     static_assert(kPorts.search(443));
+//
+// Balancing is the same code AVLTree runs (AVLBalance.hpp). Duplicates are counted
+// like in the other trees, there is no removal.
+template <typename T, size_t Capacity, typename Comparator = std::less<T>>
+class StaticAVLTree {
+    static_assert(Capacity < std::numeric_limits<uint32_t>::max(), "StaticAVLTree capacity exceeds 32-bit indices");
+
+public:
+    using value_type = T;
+    using comparator_type = Comparator;
+
+    constexpr StaticAVLTree(Comparator comparator = Comparator());
+    constexpr StaticAVLTree(std::initializer_list<T> data, Comparator comparator = Comparator());
+
+    // Throws std::length_error once all Capacity nodes are used, a compile error in constexpr
+    constexpr void insert(T data);
+
+    constexpr bool search(const T& data) const;
+    // Smallest element not less than data, nullptr if there is none
+    constexpr const T* lowerBound(const T& data) const;
+
+    constexpr const T& min() const;
+    constexpr const T& max() const;
+
+    constexpr size_t nodesCount() const { return m_nodesCount; };
+    constexpr uint64_t elementsCount() const { return m_elementsCount; };
+    constexpr bool empty() const { return m_nodesCount == 0; };
+    constexpr uint32_t getHeight() const { return m_root == kNull ? 0 : m_nodes[m_root].height; };
+    static constexpr size_t capacity() { return Capacity; };
+
+private:
+    static constexpr uint32_t kNull = std::numeric_limits<uint32_t>::max();
+
+    struct Node {
+        T data{};
+        uint64_t count{0};
+        uint32_t left{kNull};
+        uint32_t right{kNull};
+        uint32_t height{0};
+    };
+
+    // Child links for the shared balancing steps
+    struct IndexLinks {
+        std::array<Node, Capacity>* nodes;
+
+        constexpr uint32_t& left(uint32_t node) const { return (*nodes)[node].left; }
+        constexpr uint32_t& right(uint32_t node) const { return (*nodes)[node].right; }
+        constexpr int32_t balance(uint32_t node) const {
+            return static_cast<int32_t>(height(left(node))) - static_cast<int32_t>(height(right(node)));
+        }
+        constexpr void update(uint32_t node) const {
+            uint32_t leftHeight = height(left(node));
+            uint32_t rightHeight = height(right(node));
+            (*nodes)[node].height = 1 + (leftHeight > rightHeight ? leftHeight : rightHeight);
+        }
+        constexpr uint32_t height(uint32_t node) const { return node == kNull ? 0 : (*nodes)[node].height; }
+    };
+
+    // Helper for insert
+    constexpr void recursive_insert(uint32_t& node, T& data);
+
+    std::array<Node, Capacity> m_nodes{};
+    Comparator m_comparator;
+    uint32_t m_root{kNull};
+    size_t m_nodesCount{0};
+    uint64_t m_elementsCount{0};
+};
+
+template <typename T, size_t Capacity, typename Comparator>
+constexpr StaticAVLTree<T, Capacity, Comparator>::StaticAVLTree(Comparator comparator)
+: m_comparator(comparator)
+{}
+
+template <typename T, size_t Capacity, typename Comparator>
+constexpr StaticAVLTree<T, Capacity, Comparator>::StaticAVLTree(std::initializer_list<T> data, Comparator comparator)
+: m_comparator(comparator)
+{
+    for (const T& x : data) {
+        insert(x);
+    }
+}
+
+template <typename T, size_t Capacity, typename Comparator>
+constexpr void StaticAVLTree<T, Capacity, Comparator>::insert(T data) {
+    recursive_insert(m_root, data);
+    m_elementsCount++;
+}
+
+template <typename T, size_t Capacity, typename Comparator>
+constexpr void StaticAVLTree<T, Capacity, Comparator>::recursive_insert(uint32_t& node, T& data) {
+    if (node == kNull) {
+        if (m_nodesCount == Capacity) {
+            throw std::length_error("Tree is full");
+        }
+        node = static_cast<uint32_t>(m_nodesCount++);
+        m_nodes[node].data = std::move(data);
+        m_nodes[node].count = 1;
+        m_nodes[node].height = 1;
+        return;
+    }
+
+    if (m_comparator(data, m_nodes[node].data)) {
+        recursive_insert(m_nodes[node].left, data);
+    } else if (m_comparator(m_nodes[node].data, data)) {
+        recursive_insert(m_nodes[node].right, data);
+    } else {
+        m_nodes[node].count++;
+        return;
+    }
+
+    IndexLinks links{&m_nodes};
+    links.update(node);
+    avl::rebalance(links, node);
+}
+
+template <typename T, size_t Capacity, typename Comparator>
+constexpr bool StaticAVLTree<T, Capacity, Comparator>::search(const T& data) const {
+    uint32_t node = m_root;
+    while (node != kNull) {
+        if (m_comparator(data, m_nodes[node].data)) {
+            node = m_nodes[node].left;
+        } else if (m_comparator(m_nodes[node].data, data)) {
+            node = m_nodes[node].right;
+        } else {
+            return true;
+        }
+    }
+    return false;
+}
+
+template <typename T, size_t Capacity, typename Comparator>
+constexpr const T* StaticAVLTree<T, Capacity, Comparator>::lowerBound(const T& data) const {
+    const T* candidate = nullptr;
+    uint32_t node = m_root;
+    while (node != kNull) {
+        if (m_comparator(m_nodes[node].data, data)) {
+            node = m_nodes[node].right;
+        } else {
+            candidate = &m_nodes[node].data;
+            node = m_nodes[node].left;
+        }
+    }
+    return candidate;
+}
+
+template <typename T, size_t Capacity, typename Comparator>
+constexpr const T& StaticAVLTree<T, Capacity, Comparator>::min() const {
+    if (m_root == kNull) {
+        throw std::runtime_error("Tree is empty");
+    }
+    uint32_t node = m_root;
+    while (m_nodes[node].left != kNull) {
+        node = m_nodes[node].left;
+    }
+    return m_nodes[node].data;
+}
+
+template <typename T, size_t Capacity, typename Comparator>
+constexpr const T& StaticAVLTree<T, Capacity, Comparator>::max() const {
+    if (m_root == kNull) {
+        throw std::runtime_error("Tree is empty");
+    }
+    uint32_t node = m_root;
+    while (m_nodes[node].right != kNull) {
+        node = m_nodes[node].right;
+    }
+    return m_nodes[node].data;
+}
+
+} // namespace adsc
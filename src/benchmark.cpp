@@ -1,4 +1,6 @@
 #include <iostream>
+#include <iterator>
+#include <array>
 #include <chrono>
 #include <vector>
 #include <set>
@@ -7,9 +9,39 @@
 #include <random>
 #include <iomanip>
 #include <string>
+#include <thread>
+#include <mutex>
+#include <memory>
+#include <atomic>
+#include <shared_mutex>
+#include <sstream>
+#include <fstream>
+#include <cstdlib>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <queue>
+#include <unordered_set>
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
 
+#include "BinarySortingTree.hpp"
 #include "BinaryTree.hpp"
 #include "AVLTree.hpp"
+#include "SkipList.hpp"
+#include "ConcurrentAVLTree.hpp"
+#include "ConcurrentSkipList.hpp"
+#include "IntervalTree.hpp"
+#include "ShardedTree.hpp"
+#include "PrefixedKey.hpp"
+#include "LatencyHistogram.hpp"
+#include "StaticAVLTree.hpp"
+#include "LearnedIndex.hpp"
+#include "BufferedTree.hpp"
+#include "RadixTree.hpp"
+#include "RcuTree.hpp"
+#include "HugePageArena.hpp"
 
 // Helper structure to hold results
 struct BenchResult {
@@ -18,6 +50,9 @@ struct BenchResult {
     int finalHeight;
 };
 
+// Keeps the optimizer from dropping otherwise unused results
+volatile size_t benchmarkSink = 0;
+
 // Helper to measure a specific tree implementation
 template<typename TreeType>
 BenchResult measure(const std::vector<int>& data) {
@@ -67,6 +102,1094 @@ BenchResult measureMultiset(const std::vector<int>& data) {
     };
 }
 
+// Serializes every operation of a single-threaded container behind one mutex
+template<typename SetType>
+class Locked {
+public:
+    void insert(int x) { std::lock_guard<std::mutex> lock(m_mutex); m_set.insert(x); }
+    void remove(int x) { std::lock_guard<std::mutex> lock(m_mutex); m_set.remove(x); }
+    bool search(int x) { std::lock_guard<std::mutex> lock(m_mutex); return m_set.search(x); }
+
+private:
+    std::mutex m_mutex;
+    SetType m_set;
+};
+
+// Readers share a reader-writer lock, writers take it exclusively
+template<typename SetType>
+class ReadLocked {
+public:
+    void insert(int x) { std::unique_lock<std::shared_mutex> lock(m_mutex); m_set.insert(x); }
+    void remove(int x) { std::unique_lock<std::shared_mutex> lock(m_mutex); m_set.remove(x); }
+    bool search(int x) { std::shared_lock<std::shared_mutex> lock(m_mutex); return m_set.search(x); }
+
+private:
+    std::shared_mutex m_mutex;
+    SetType m_set;
+};
+
+// Mixed workload (50% search, 25% insert, 25% remove), returns millions of ops per second
+template<typename SetType>
+double measureThroughput(int threads, int opsPerThread, int keyRange) {
+    SetType set;
+    for (int x = 0; x < keyRange; x += 2) set.insert(x);
+
+    std::vector<std::thread> workers;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&set, t, opsPerThread, keyRange] {
+            std::mt19937 g(t);
+            for (int i = 0; i < opsPerThread; ++i) {
+                uint32_t r = g();
+                int x = static_cast<int>((r >> 2) % keyRange);
+                switch (r & 3) {
+                    case 0: set.insert(x); break;
+                    case 1: set.remove(x); break;
+                    default: set.search(x);
+                }
+            }
+        });
+    }
+    for (auto& worker : workers) worker.join();
+    auto end = std::chrono::high_resolution_clock::now();
+
+    double seconds = std::chrono::duration<double>(end - start).count();
+    return threads * static_cast<double>(opsPerThread) / seconds / 1e6;
+}
+
+void benchmarkThreadScaling() {
+    // The total work stays fixed, so the columns compare directly across thread counts
+    const int totalOps = 1 << 21;
+    const int keyRange = 1 << 16;
+    const int maxThreads = 64;
+
+    std::cout << "\n" << std::string(70, '=') << "\n";
+    std::cout << "  THREAD SCALING (Mops/s, key range = " << keyRange << ")\n";
+    std::cout << std::string(70, '=') << "\n";
+    std::cout << std::left << std::setw(10) << "Threads"
+              << std::setw(17) << "AVLTree+mutex"
+              << std::setw(17) << "SkipList+mutex"
+              << std::setw(14) << "Sharded"
+              << std::setw(12) << "Concurrent" << std::endl;
+    std::cout << std::string(70, '-') << std::endl;
+
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        int opsPerThread = totalOps / threads;
+        std::cout << std::left << std::setw(10) << threads
+                  << std::setw(17) << measureThroughput<Locked<adsc::AVLTree<int>>>(threads, opsPerThread, keyRange)
+                  << std::setw(17) << measureThroughput<Locked<adsc::SkipList<int>>>(threads, opsPerThread, keyRange)
+                  << std::setw(14) << measureThroughput<adsc::ShardedTree<int>>(threads, opsPerThread, keyRange)
+                  << std::setw(12) << measureThroughput<adsc::ConcurrentSkipList<int>>(threads, opsPerThread, keyRange)
+                  << std::endl;
+    }
+}
+
+struct ChurnResult {
+    double readMops;
+    double writeKops;
+};
+
+// Reader threads searching while one writer inserts and removes without pause
+template<typename SetType>
+ChurnResult measureReadsUnderChurn(int readers, int keyRange, std::chrono::milliseconds duration) {
+    SetType set;
+    for (int x = 0; x < keyRange; x += 2) set.insert(x);
+
+    std::atomic<bool> done{false};
+    std::atomic<uint64_t> reads{0};
+    std::atomic<size_t> hits{0};
+    uint64_t writes = 0;
+    std::vector<std::thread> threads;
+    for (int r = 0; r < readers; ++r) {
+        threads.emplace_back([&set, &done, &reads, &hits, r, keyRange] {
+            std::mt19937 g(r);
+            uint64_t local = 0;
+            size_t found = 0;
+            while (!done.load(std::memory_order_relaxed)) {
+                found += set.search(static_cast<int>(g() % keyRange));
+                local++;
+            }
+            reads += local;
+            hits += found;
+        });
+    }
+    std::thread writer([&] {
+        std::mt19937 g(1000);
+        while (!done.load(std::memory_order_relaxed)) {
+            int x = static_cast<int>(g() % keyRange);
+            if (writes % 2) set.remove(x);
+            else set.insert(x);
+            writes++;
+        }
+    });
+
+    auto start = std::chrono::high_resolution_clock::now();
+    std::this_thread::sleep_for(duration);
+    done = true;
+    for (auto& thread : threads) thread.join();
+    writer.join();
+    auto end = std::chrono::high_resolution_clock::now();
+    benchmarkSink = hits;
+
+    double seconds = std::chrono::duration<double>(end - start).count();
+    return {reads / seconds / 1e6, writes / seconds / 1e3};
+}
+
+void benchmarkReadChurn() {
+    const int keyRange = 1 << 20;
+    const auto duration = std::chrono::milliseconds(500);
+
+    std::cout << "\n" << std::string(76, '=') << "\n";
+    std::cout << "  READS UNDER WRITE CHURN (reads Mops/s / writes Kops/s, key range = " << keyRange << ")\n";
+    std::cout << std::string(76, '=') << "\n";
+    std::cout << std::left << std::setw(10) << "Readers"
+              << std::setw(22) << "AVLTree+rwlock"
+              << std::setw(22) << "Sharded"
+              << std::setw(22) << "ConcurrentAVL" << std::endl;
+    std::cout << std::string(76, '-') << std::endl;
+
+    auto cell = [](ChurnResult r) {
+        std::ostringstream out;
+        out << std::fixed << std::setprecision(2) << r.readMops << " / " << std::setprecision(1) << r.writeKops;
+        return out.str();
+    };
+    for (int readers = 1; readers <= 8; readers *= 2) {
+        std::cout << std::left << std::setw(10) << readers
+                  << std::setw(22) << cell(measureReadsUnderChurn<ReadLocked<adsc::AVLTree<int>>>(readers, keyRange, duration))
+                  << std::setw(22) << cell(measureReadsUnderChurn<adsc::ShardedTree<int>>(readers, keyRange, duration))
+                  << std::setw(22) << cell(measureReadsUnderChurn<adsc::ConcurrentAVLTree<int>>(readers, keyRange, duration))
+                  << std::endl;
+    }
+}
+
+// One configuration rewrite: the keys of out leave the set, the keys of in join it
+template<typename SetType>
+void rewriteBatch(SetType& set, const std::vector<int>& out, const std::vector<int>& in) {
+    for (int x : out) set.remove(x);
+    for (int x : in) set.insert(x);
+}
+
+template<>
+void rewriteBatch(adsc::RcuTree<int>& set, const std::vector<int>& out, const std::vector<int>& in) {
+    set.update([&](adsc::RcuTree<int>::Tree& next) {
+        for (int x : out) next.remove(x);
+        for (int x : in) next.insert(x);
+    });
+}
+
+// Reads/s of a configuration-sized set rewritten in batches every few milliseconds
+template<typename SetType>
+double measureReadScaling(int readers, int keys, std::chrono::milliseconds duration) {
+    SetType set;
+    for (int x = 0; x < keys; ++x) set.insert(2 * x);
+
+    std::atomic<bool> done{false};
+    std::atomic<uint64_t> reads{0};
+    std::atomic<size_t> hits{0};
+    std::vector<std::thread> threads;
+    for (int r = 0; r < readers; ++r) {
+        threads.emplace_back([&set, &done, &reads, &hits, r, keys] {
+            std::mt19937 g(r);
+            uint64_t local = 0;
+            size_t found = 0;
+            while (!done.load(std::memory_order_relaxed)) {
+                found += set.search(static_cast<int>(g() % (2u * keys)));
+                local++;
+            }
+            reads += local;
+            hits += found;
+        });
+    }
+    std::thread writer([&] {
+        // Shifts 100 keys from even to odd and back every round
+        std::vector<int> even(100), odd(100);
+        for (int round = 0; !done.load(std::memory_order_relaxed); ++round) {
+            for (int i = 0; i < 100; ++i) {
+                even[i] = 2 * ((round * 100 + i) % keys);
+                odd[i] = even[i] + 1;
+            }
+            rewriteBatch(set, even, odd);
+            rewriteBatch(set, odd, even);
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+    });
+
+    auto start = std::chrono::high_resolution_clock::now();
+    std::this_thread::sleep_for(duration);
+    done = true;
+    for (auto& thread : threads) thread.join();
+    writer.join();
+    auto end = std::chrono::high_resolution_clock::now();
+    benchmarkSink = hits;
+
+    return reads / std::chrono::duration<double>(end - start).count() / 1e6;
+}
+
+void benchmarkReadScaling() {
+    const int keys = 10000;
+    const auto duration = std::chrono::milliseconds(300);
+
+    std::cout << "\n" << std::string(70, '=') << "\n";
+    std::cout << "  READ SCALING, SET REWRITTEN IN BATCHES (reads Mops/s, " << keys << " keys)\n";
+    std::cout << std::string(70, '=') << "\n";
+    std::cout << std::left << std::setw(10) << "Readers"
+              << std::setw(20) << "AVLTree+rwlock"
+              << std::setw(20) << "ConcurrentAVL"
+              << std::setw(20) << "RcuTree" << std::endl;
+    std::cout << std::string(70, '-') << std::endl;
+
+    for (int readers = 1; readers <= 64; readers *= 2) {
+        std::cout << std::left << std::setw(10) << readers
+                  << std::setw(20) << measureReadScaling<ReadLocked<adsc::AVLTree<int>>>(readers, keys, duration)
+                  << std::setw(20) << measureReadScaling<adsc::ConcurrentAVLTree<int>>(readers, keys, duration)
+                  << std::setw(20) << measureReadScaling<adsc::RcuTree<int>>(readers, keys, duration)
+                  << std::endl;
+    }
+}
+
+// Bursts of deletes followed by re-inserting the same keys, the pattern lazy removal targets
+void benchmarkLazyRemoval() {
+    const int N = 100000;
+    const int rounds = 20;
+    const int burst = N / 5;
+
+    std::vector<int> data(N);
+    std::iota(data.begin(), data.end(), 1);
+    std::mt19937 g(11);
+    std::shuffle(data.begin(), data.end(), g);
+
+    std::cout << "\n" << std::string(60, '=') << "\n";
+    std::cout << "  BURST DELETE / RE-INSERT (N = " << N << ", burst = " << burst << ")\n";
+    std::cout << std::string(60, '=') << "\n";
+    std::cout << std::left << std::setw(20) << "Mode"
+              << std::setw(14) << "Remove (s)"
+              << std::setw(14) << "Insert (s)"
+              << std::setw(12) << "ns/op" << std::endl;
+    std::cout << std::string(60, '-') << std::endl;
+
+    auto run = [&](const std::string& name, bool lazy, double ratio) {
+        adsc::AVLTree<int> tree;
+        tree.setLazyRemoval(lazy, ratio);
+        for (int x : data) tree.insert(x);
+
+        std::mt19937 pick(3);
+        std::vector<int> keys(data);
+        double removeTime = 0;
+        double insertTime = 0;
+        for (int r = 0; r < rounds; ++r) {
+            std::shuffle(keys.begin(), keys.end(), pick);
+
+            auto start = std::chrono::high_resolution_clock::now();
+            for (int i = 0; i < burst; ++i) tree.remove(keys[i]);
+            auto middle = std::chrono::high_resolution_clock::now();
+            for (int i = 0; i < burst; ++i) tree.insert(keys[i]);
+            auto end = std::chrono::high_resolution_clock::now();
+
+            removeTime += std::chrono::duration<double>(middle - start).count();
+            insertTime += std::chrono::duration<double>(end - middle).count();
+        }
+
+        std::cout << std::left << std::setw(20) << name
+                  << std::setw(14) << removeTime
+                  << std::setw(14) << insertTime
+                  << std::setw(12) << (removeTime + insertTime) * 1e9 / (2.0 * rounds * burst)
+                  << std::endl;
+    };
+
+    run("AVLTree eager", false, 0.0);
+    run("AVLTree lazy 0.25", true, 0.25);
+    run("AVLTree lazy 0.50", true, 0.5);
+}
+
+// Overlap queries: IntervalTree vs a linear scan and a vector sorted by start point
+void benchmarkIntervals() {
+    const int N = 200000;
+    const int queries = 2000;
+    const int domain = 100000000;
+
+    std::mt19937 g(17);
+    std::vector<adsc::Interval<int>> intervals(N);
+    for (auto& interval : intervals) {
+        interval.start = static_cast<int>(g() % domain);
+        interval.end = interval.start + static_cast<int>(g() % 5000);
+    }
+    std::vector<std::pair<int, int>> windows(queries);
+    for (auto& window : windows) {
+        window.first = static_cast<int>(g() % domain);
+        window.second = window.first + static_cast<int>(g() % 1000);
+    }
+
+    adsc::IntervalTree<int> tree;
+    for (const auto& interval : intervals) tree.insert(interval);
+
+    std::vector<adsc::Interval<int>> sorted(intervals);
+    std::sort(sorted.begin(), sorted.end(), adsc::IntervalLess<int>());
+
+    std::cout << "\n" << std::string(60, '=') << "\n";
+    std::cout << "  OVERLAP QUERIES (N = " << N << ", queries = " << queries << ")\n";
+    std::cout << std::string(60, '=') << "\n";
+    std::cout << std::left << std::setw(20) << "Structure"
+              << std::setw(16) << "Queries/s"
+              << std::setw(12) << "Hits" << std::endl;
+    std::cout << std::string(60, '-') << std::endl;
+
+    auto run = [&](const std::string& name, auto&& query) {
+        size_t hits = 0;
+        auto start = std::chrono::high_resolution_clock::now();
+        for (const auto& window : windows) hits += query(window.first, window.second);
+        auto end = std::chrono::high_resolution_clock::now();
+        std::cout << std::left << std::setw(20) << name
+                  << std::setw(16) << queries / std::chrono::duration<double>(end - start).count()
+                  << std::setw(12) << hits << std::endl;
+    };
+
+    run("IntervalTree", [&](int s, int e) {
+        size_t hits = 0;
+        tree.overlapping(s, e, [&hits](const adsc::Interval<int>&) { hits++; });
+        return hits;
+    });
+    run("Sorted vector", [&](int s, int e) {
+        // Everything starting after e is out, the prefix still needs an end check
+        auto last = std::upper_bound(sorted.begin(), sorted.end(), e,
+            [](int value, const adsc::Interval<int>& interval) { return value < interval.start; });
+        size_t hits = 0;
+        for (auto it = sorted.begin(); it != last; ++it) hits += it->end >= s;
+        return hits;
+    });
+    run("Linear scan", [&](int s, int e) {
+        size_t hits = 0;
+        for (const auto& interval : intervals) hits += interval.start <= e && s <= interval.end;
+        return hits;
+    });
+}
+
+// Timestamps arriving almost in order: every key is displaced by at most a small jitter
+void benchmarkNearlySorted() {
+    const int N = 1000000;
+    const int jitter = 64;
+    std::vector<int> data(N);
+    std::mt19937 g(29);
+    for (int i = 0; i < N; ++i) data[i] = i * 4 + static_cast<int>(g() % (4 * jitter));
+
+    std::cout << "\n" << std::string(60, '=') << "\n";
+    std::cout << "  NEARLY SORTED INSERTS (N = " << N << ", jitter = " << jitter << ")\n";
+    std::cout << std::string(60, '=') << "\n";
+    std::cout << std::left << std::setw(24) << "Structure"
+              << std::setw(16) << "Insert (s)"
+              << std::setw(12) << "ns/op" << std::endl;
+    std::cout << std::string(60, '-') << std::endl;
+
+    auto run = [&](const std::string& name, auto&& insertAll) {
+        auto start = std::chrono::high_resolution_clock::now();
+        insertAll();
+        auto end = std::chrono::high_resolution_clock::now();
+        double seconds = std::chrono::duration<double>(end - start).count();
+        std::cout << std::left << std::setw(24) << name
+                  << std::setw(16) << seconds
+                  << std::setw(12) << seconds * 1e9 / N << std::endl;
+    };
+
+    run("AVLTree", [&] {
+        adsc::AVLTree<int> tree;
+        for (int x : data) tree.insert(x);
+    });
+    run("AVLTree NearMax hint", [&] {
+        adsc::AVLTree<int> tree;
+        for (int x : data) tree.insert(adsc::InsertHint::NearMax, x);
+    });
+    run("AVLTree finger", [&] {
+        adsc::AVLTree<int> tree;
+        tree.setFingerSearch(true);
+        for (int x : data) tree.insert(x);
+    });
+    run("std::multiset", [&] {
+        std::multiset<int> ms;
+        for (int x : data) ms.insert(x);
+    });
+    run("std::multiset end hint", [&] {
+        std::multiset<int> ms;
+        for (int x : data) ms.insert(ms.end(), x);
+    });
+}
+
+// Lookups on a tree far beyond the last level cache: search() loop vs searchBatch()
+void benchmarkBatchSearch() {
+    const int N = 1 << 23;
+    const int lookups = 1 << 21;
+    const size_t batch = 512;
+
+    std::vector<int> data(N);
+    std::iota(data.begin(), data.end(), 0);
+    std::mt19937 g(31);
+    std::shuffle(data.begin(), data.end(), g);
+
+    adsc::AVLTree<int> tree;
+    for (int x : data) tree.insert(x * 2);
+
+    std::vector<int> keys(lookups);
+    for (int& key : keys) key = static_cast<int>(g() % (2u * N));
+
+    std::cout << "\n" << std::string(60, '=') << "\n";
+    std::cout << "  BATCHED LOOKUPS (N = " << N << ", batch = " << batch << ")\n";
+    std::cout << std::string(60, '=') << "\n";
+    std::cout << std::left << std::setw(24) << "Method"
+              << std::setw(16) << "Lookups/s"
+              << std::setw(12) << "Hits" << std::endl;
+    std::cout << std::string(60, '-') << std::endl;
+
+    auto report = [&](const std::string& name, double seconds, size_t hits) {
+        std::cout << std::left << std::setw(24) << name
+                  << std::setw(16) << lookups / seconds
+                  << std::setw(12) << hits << std::endl;
+    };
+
+    size_t hits = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int key : keys) hits += tree.search(key);
+    auto end = std::chrono::high_resolution_clock::now();
+    report("search() loop", std::chrono::duration<double>(end - start).count(), hits);
+
+    hits = 0;
+    std::vector<int> chunk;
+    std::vector<char> results;
+    start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < keys.size(); i += batch) {
+        chunk.assign(keys.begin() + i, keys.begin() + std::min(keys.size(), i + batch));
+        tree.searchBatch(chunk, results);
+        for (char found : results) hits += found;
+    }
+    end = std::chrono::high_resolution_clock::now();
+    report("searchBatch()", std::chrono::duration<double>(end - start).count(), hits);
+}
+
+// Anonymous memory of the process currently backed by transparent huge pages, in MB
+double anonHugePagesMB() {
+    std::ifstream rollup("/proc/self/smaps_rollup");
+    std::string field;
+    while (rollup >> field) {
+        if (field == "AnonHugePages:") {
+            double kb = 0;
+            rollup >> kb;
+            return kb / 1024;
+        }
+    }
+    return 0;
+}
+
+// Random lookups in a tree far beyond the TLB reach, nodes from malloc vs from 2MB pages
+template<typename Tree>
+void measureHugePages(const std::string& name, const std::vector<int>& data, const std::vector<int>& keys) {
+    double hugeBefore = anonHugePagesMB();
+    Tree tree;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int x : data) tree.insert(x * 2);
+    auto built = std::chrono::high_resolution_clock::now();
+    size_t hits = 0;
+    for (int key : keys) hits += tree.search(key);
+    auto end = std::chrono::high_resolution_clock::now();
+    benchmarkSink = hits;
+
+    std::cout << std::left << std::setw(24) << name
+              << std::setw(14) << std::chrono::duration<double>(built - start).count()
+              << std::setw(16) << std::chrono::duration<double, std::nano>(end - built).count() / keys.size()
+              << std::setw(14) << anonHugePagesMB() - hugeBefore << std::endl;
+}
+
+void benchmarkHugePages() {
+    const int N = 1 << 22;
+    const int lookups = 1 << 21;
+
+    std::vector<int> data(N);
+    std::iota(data.begin(), data.end(), 0);
+    std::mt19937 g(37);
+    std::shuffle(data.begin(), data.end(), g);
+    std::vector<int> keys(lookups);
+    for (int& key : keys) key = static_cast<int>(g() % (2u * N));
+
+    std::cout << "\n" << std::string(68, '=') << "\n";
+    std::cout << "  HUGE PAGE NODES (N = " << N << ", random lookups)\n";
+    std::cout << std::string(68, '=') << "\n";
+    std::cout << std::left << std::setw(24) << "Allocation"
+              << std::setw(14) << "Build (s)"
+              << std::setw(16) << "Lookup (ns/op)"
+              << std::setw(14) << "THP (MB)" << std::endl;
+    std::cout << std::string(68, '-') << std::endl;
+
+    using HugeTree = adsc::AVLTree<int, std::less<int>, adsc::NoAugmentation<int>, adsc::HugePageNodeLayout<>>;
+    measureHugePages<adsc::AVLTree<int>>("operator new (4KB)", data, keys);
+    measureHugePages<HugeTree>("HugePageArena (2MB)", data, keys);
+    if (!adsc::HugePageArena<>::stats().hugePages) {
+        std::cout << "madvise(MADV_HUGEPAGE) refused, the arena ran on 4KB pages" << std::endl;
+    }
+}
+
+// Insert and look up N prebuilt keys, returns {insert, search} seconds
+template<typename Tree, typename Key>
+std::pair<double, double> measureKeys(std::vector<Key> inserts, const std::vector<Key>& probes) {
+    Tree tree;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (Key& key : inserts) tree.insert(std::move(key));
+    auto middle = std::chrono::high_resolution_clock::now();
+    size_t hits = 0;
+    for (const Key& key : probes) hits += tree.search(key);
+    auto end = std::chrono::high_resolution_clock::now();
+    benchmarkSink = hits;
+    return {std::chrono::duration<double>(middle - start).count(),
+            std::chrono::duration<double>(end - middle).count()};
+}
+
+// Node layouts for large keys: inline key vs cache-aligned node vs out-of-line key with prefix
+template<size_t KeySize>
+void benchmarkLargeKeys(int N) {
+    using Key = std::array<char, KeySize>;
+    std::vector<Key> keys(N);
+    std::mt19937 g(37);
+    for (Key& key : keys)
+        for (char& c : key) c = static_cast<char>(g());
+
+    std::cout << "\n" << std::string(60, '=') << "\n";
+    std::cout << "  " << KeySize << "-BYTE KEYS (N = " << N << ")\n";
+    std::cout << std::string(60, '=') << "\n";
+    std::cout << std::left << std::setw(28) << "Layout"
+              << std::setw(16) << "Insert (s)"
+              << std::setw(16) << "Search (s)" << std::endl;
+    std::cout << std::string(60, '-') << std::endl;
+
+    auto report = [](const std::string& name, std::pair<double, double> res) {
+        std::cout << std::left << std::setw(28) << name
+                  << std::setw(16) << res.first
+                  << std::setw(16) << res.second << std::endl;
+    };
+    using Prefixed = adsc::PrefixedKey<Key>;
+    std::vector<Prefixed> prefixed(keys.begin(), keys.end());
+
+    report("AVLTree default", measureKeys<adsc::AVLTree<Key>>(keys, keys));
+    report("AVLTree cache aligned", measureKeys<adsc::AVLTree<Key, std::less<Key>,
+        adsc::NoAugmentation<Key>, adsc::CacheAlignedNodeLayout>>(keys, keys));
+    report("AVLTree prefixed, aligned", measureKeys<adsc::AVLTree<Prefixed, std::less<Prefixed>,
+        adsc::NoAugmentation<Prefixed>, adsc::CacheAlignedNodeLayout>>(prefixed, prefixed));
+}
+
+// Ordered extraction of a whole tree: removeMin loop vs drain, and a k-way shard merge
+void benchmarkDrain() {
+    const int N = 1000000;
+    const int shards = 8;
+    std::vector<int> data(N);
+    std::iota(data.begin(), data.end(), 1);
+    std::mt19937 g(41);
+    std::shuffle(data.begin(), data.end(), g);
+
+    std::cout << "\n" << std::string(60, '=') << "\n";
+    std::cout << "  ORDERED DRAIN (N = " << N << ", shards = " << shards << ")\n";
+    std::cout << std::string(60, '=') << "\n";
+    std::cout << std::left << std::setw(28) << "Method"
+              << std::setw(16) << "Drain (s)"
+              << std::setw(12) << "ns/elem" << std::endl;
+    std::cout << std::string(60, '-') << std::endl;
+
+    auto run = [&](const std::string& name, auto&& drainAll) {
+        std::vector<adsc::AVLTree<int>> trees(shards);
+        for (int i = 0; i < N; ++i) trees[i % shards].insert(data[i]);
+        std::vector<int> out;
+        out.reserve(N);
+
+        auto start = std::chrono::high_resolution_clock::now();
+        drainAll(trees, out);
+        auto end = std::chrono::high_resolution_clock::now();
+        double seconds = std::chrono::duration<double>(end - start).count();
+        benchmarkSink = out.size();
+        std::cout << std::left << std::setw(28) << name
+                  << std::setw(16) << seconds
+                  << std::setw(12) << seconds * 1e9 / N << std::endl;
+    };
+
+    using Shards = std::vector<adsc::AVLTree<int>>;
+    run("removeMin loop, per shard", [](Shards& trees, std::vector<int>& out) {
+        for (auto& tree : trees)
+            while (!tree.empty()) out.push_back(tree.removeMin());
+    });
+    run("drain(), per shard", [](Shards& trees, std::vector<int>& out) {
+        for (auto& tree : trees) tree.drain(std::back_inserter(out));
+    });
+    run("k-way min()/removeMin", [](Shards& trees, std::vector<int>& out) {
+        while (true) {
+            adsc::AVLTree<int>* next = nullptr;
+            for (auto& tree : trees)
+                if (!tree.empty() && (!next || tree.min() < next->min())) next = &tree;
+            if (!next) break;
+            out.push_back(next->removeMin());
+        }
+    });
+    run("mergeDrain()", [](Shards& trees, std::vector<int>& out) {
+        std::vector<adsc::AVLTree<int>*> pointers;
+        for (auto& tree : trees) pointers.push_back(&tree);
+        adsc::mergeDrain(pointers, std::back_inserter(out));
+    });
+}
+
+// Histogram building: a million copies spread over 1000 buckets, one at a time vs in bulk
+void benchmarkHistogram() {
+    const int buckets = 1000;
+    const uint64_t copies = 1000;
+
+    std::cout << "\n" << std::string(60, '=') << "\n";
+    std::cout << "  HISTOGRAM (" << buckets << " keys x " << copies << " copies)\n";
+    std::cout << std::string(60, '=') << "\n";
+    std::cout << std::left << std::setw(24) << "Method"
+              << std::setw(16) << "Build (s)"
+              << std::setw(16) << "Drain (s)" << std::endl;
+    std::cout << std::string(60, '-') << std::endl;
+
+    auto run = [&](const std::string& name, auto&& build, auto&& drain) {
+        adsc::AVLTree<int> tree;
+        auto start = std::chrono::high_resolution_clock::now();
+        build(tree);
+        auto middle = std::chrono::high_resolution_clock::now();
+        drain(tree);
+        auto end = std::chrono::high_resolution_clock::now();
+        std::cout << std::left << std::setw(24) << name
+                  << std::setw(16) << std::chrono::duration<double>(middle - start).count()
+                  << std::setw(16) << std::chrono::duration<double>(end - middle).count() << std::endl;
+    };
+
+    run("insert / removeMin", [&](adsc::AVLTree<int>& tree) {
+        for (uint64_t c = 0; c < copies; ++c)
+            for (int key = 0; key < buckets; ++key) tree.insert(key);
+    }, [](adsc::AVLTree<int>& tree) {
+        while (!tree.empty()) tree.removeMin();
+    });
+    run("insert(key, n) bulk", [&](adsc::AVLTree<int>& tree) {
+        for (int key = 0; key < buckets; ++key) tree.insert(key, copies);
+    }, [](adsc::AVLTree<int>& tree) {
+        while (!tree.empty()) tree.removeMin(UINT64_MAX);
+    });
+}
+
+// Generic algorithm written once against any tree: fill, probe every key, drain in order
+template<typename Tree>
+size_t fillProbeDrain(Tree& tree, const std::vector<int>& data) {
+    size_t checksum = 0;
+    for (int x : data) tree.insert(x);
+    for (int x : data) checksum += tree.search(x);
+    while (!tree.empty()) checksum += static_cast<size_t>(tree.removeMin());
+    return checksum;
+}
+
+// Lookup table of the odd keys below 2 * kStaticTableSize, built by the compiler
+constexpr int kStaticTableSize = 1024;
+
+constexpr adsc::StaticAVLTree<int, kStaticTableSize> makeStaticTable() {
+    adsc::StaticAVLTree<int, kStaticTableSize> table;
+    // Scattered insertion order, multiplying by an odd constant permutes the residues
+    for (int i = 0; i < kStaticTableSize; ++i) table.insert(2 * ((i * 2654435761u) % kStaticTableSize) + 1);
+    return table;
+}
+
+constexpr auto kStaticTable = makeStaticTable();
+
+// Compile-time table against the same table built at startup through AVLTree::insert
+void benchmarkStaticTable() {
+    const int probes = 2000000;
+    std::vector<int> keys(probes);
+    std::mt19937 g(31);
+    for (int& x : keys) x = static_cast<int>(g() % (2 * kStaticTableSize));
+
+    std::cout << "\n" << std::string(60, '=') << "\n";
+    std::cout << "  STATIC LOOKUP TABLE (" << kStaticTableSize << " keys, " << probes << " probes)\n";
+    std::cout << std::string(60, '=') << "\n";
+    std::cout << std::left << std::setw(24) << "Structure"
+              << std::setw(16) << "Build (s)"
+              << std::setw(16) << "Lookup (s)" << std::endl;
+    std::cout << std::string(60, '-') << std::endl;
+
+    auto lookup = [&](const auto& table) {
+        size_t hits = 0;
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int x : keys) hits += table.search(x);
+        auto end = std::chrono::high_resolution_clock::now();
+        benchmarkSink = hits;
+        return std::chrono::duration<double>(end - start).count();
+    };
+
+    auto start = std::chrono::high_resolution_clock::now();
+    adsc::AVLTree<int> tree;
+    for (int i = 0; i < kStaticTableSize; ++i) tree.insert(2 * ((i * 2654435761u) % kStaticTableSize) + 1);
+    auto end = std::chrono::high_resolution_clock::now();
+
+    std::cout << std::left << std::setw(24) << "AVLTree at startup"
+              << std::setw(16) << std::chrono::duration<double>(end - start).count()
+              << std::setw(16) << lookup(tree) << std::endl;
+    std::cout << std::left << std::setw(24) << "StaticAVLTree constexpr"
+              << std::setw(16) << 0.0
+              << std::setw(16) << lookup(kStaticTable) << std::endl;
+}
+
+// Sorted keys in breadth-first order of an implicit complete tree (Eytzinger layout),
+// the usual cache friendly baseline for searching a static array
+template<typename T>
+class EytzingerArray {
+public:
+    explicit EytzingerArray(const std::vector<T>& sorted) : m_keys(sorted.size() + 1) {
+        size_t next = 0;
+        fill(sorted, next, 1);
+    }
+
+    bool search(const T& key) const {
+        size_t k = 1;
+        while (k < m_keys.size()) {
+            // The 16 descendants four levels down share one cache line
+#if defined(__GNUC__) || defined(__clang__)
+            __builtin_prefetch(m_keys.data() + std::min(16 * k, m_keys.size() - 1));
+#endif
+            k = 2 * k + (m_keys[k] < key);
+        }
+        // Undo the right turns after the last left turn, that node is the lower bound
+#if defined(__GNUC__) || defined(__clang__)
+        k >>= __builtin_ffsll(~static_cast<unsigned long long>(k));
+#else
+        int turns = 1;
+        for (size_t rest = k; rest & 1; rest >>= 1) turns++;
+        k >>= turns;
+#endif
+        return k != 0 && m_keys[k] == key;
+    }
+
+private:
+    void fill(const std::vector<T>& sorted, size_t& next, size_t k) {
+        if (k < m_keys.size()) {
+            fill(sorted, next, 2 * k);
+            m_keys[k] = sorted[next++];
+            fill(sorted, next, 2 * k + 1);
+        }
+    }
+
+    std::vector<T> m_keys;
+};
+
+// Frozen lookups on uniform and skewed keys: tree descent, Eytzinger array, learned index
+void benchmarkLearnedIndex() {
+    const int N = 2000000;
+    const int probes = 4000000;
+
+    std::cout << "\n" << std::string(70, '=') << "\n";
+    std::cout << "  FROZEN LOOKUPS (N = " << N << ", " << probes << " probes, half hits)\n";
+    std::cout << std::string(70, '=') << "\n";
+    std::cout << std::left << std::setw(12) << "Keys"
+              << std::setw(14) << "AVLTree (s)"
+              << std::setw(14) << "Eytzinger (s)"
+              << std::setw(14) << "Learned (s)"
+              << std::setw(12) << "Segments" << std::endl;
+    std::cout << std::string(70, '-') << std::endl;
+
+    auto run = [&](const std::string& name, auto&& next) {
+        std::mt19937_64 g(37);
+        std::set<uint64_t> unique;
+        while (unique.size() < static_cast<size_t>(N)) unique.insert(next(g));
+        std::vector<uint64_t> sorted(unique.begin(), unique.end());
+
+        std::vector<uint64_t> keys(sorted);
+        std::shuffle(keys.begin(), keys.end(), g);
+        adsc::AVLTree<uint64_t> tree;
+        for (uint64_t x : keys) tree.insert(x);
+        EytzingerArray<uint64_t> eytzinger(sorted);
+        adsc::LearnedIndex<uint64_t> learned(tree);
+
+        // Misses fall between neighbouring keys, in range of the model
+        std::vector<uint64_t> queries(probes);
+        for (uint64_t& x : queries) {
+            x = sorted[g() % sorted.size()];
+            if (g() & 1) x += 1;
+        }
+
+        auto time = [&](const auto& index) {
+            size_t hits = 0;
+            auto start = std::chrono::high_resolution_clock::now();
+            for (uint64_t x : queries) hits += index.search(x);
+            auto end = std::chrono::high_resolution_clock::now();
+            benchmarkSink = hits;
+            return std::chrono::duration<double>(end - start).count();
+        };
+
+        std::cout << std::left << std::setw(12) << name
+                  << std::setw(14) << time(tree)
+                  << std::setw(14) << time(eytzinger)
+                  << std::setw(14) << time(learned)
+                  << std::setw(12) << learned.segmentsCount() << std::endl;
+    };
+
+    run("uniform", [](std::mt19937_64& g) { return g() >> 16; });
+    std::lognormal_distribution<double> skewed(20.0, 2.0);
+    run("lognormal", [&](std::mt19937_64& g) { return static_cast<uint64_t>(skewed(g)); });
+}
+
+// Same algorithm through the static API and through the type-erased adapter
+void benchmarkDispatch() {
+    const int N = 200000;
+    const int rounds = 5;
+    std::vector<int> data(N);
+    std::iota(data.begin(), data.end(), 1);
+    std::mt19937 g(23);
+    std::shuffle(data.begin(), data.end(), g);
+
+    std::cout << "\n" << std::string(60, '=') << "\n";
+    std::cout << "  STATIC VS VIRTUAL DISPATCH (N = " << N << ", rounds = " << rounds << ")\n";
+    std::cout << std::string(60, '=') << "\n";
+    std::cout << std::left << std::setw(20) << "Structure"
+              << std::setw(16) << "Static (s)"
+              << std::setw(16) << "Virtual (s)" << std::endl;
+    std::cout << std::string(60, '-') << std::endl;
+
+    auto time = [&](auto&& makeTree) {
+        size_t checksum = 0;
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int r = 0; r < rounds; ++r) {
+            auto tree = makeTree();
+            checksum += fillProbeDrain(*tree, data);
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        benchmarkSink = checksum;
+        return std::chrono::duration<double>(end - start).count();
+    };
+
+    auto run = [&](const std::string& name, auto tag) {
+        using Tree = typename decltype(tag)::type;
+        double direct = time([] { return std::make_unique<Tree>(); });
+        double erased = time([] {
+            return std::unique_ptr<adsc::BinarySortingTree<int>>(new adsc::TreeAdapter<Tree>());
+        });
+        std::cout << std::left << std::setw(20) << name
+                  << std::setw(16) << direct
+                  << std::setw(16) << erased << std::endl;
+    };
+
+    run("AVLTree", std::common_type<adsc::AVLTree<int>>());
+    run("SkipList", std::common_type<adsc::SkipList<int>>());
+}
+
+// Per-operation latency of one tree type, one histogram per operation
+struct LatencyReport {
+    std::string tree;
+    std::vector<std::pair<std::string, adsc::LatencyHistogram>> operations;
+};
+
+// Times a single call with steady_clock, the clock read costs a few tens of ns
+template<typename Op>
+inline void timeOperation(adsc::LatencyHistogram& histogram, Op&& op) {
+    auto start = std::chrono::steady_clock::now();
+    op();
+    auto end = std::chrono::steady_clock::now();
+    histogram.record(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+}
+
+// Random inserts, hits, removes of half the keys in random order, removeMin of the rest
+template<typename Tree>
+LatencyReport measureLatency(const std::string& name, Tree& tree, const std::vector<int>& data) {
+    adsc::LatencyHistogram insert, search, remove, removeMin;
+    std::vector<int> keys(data);
+    std::mt19937 g(41);
+    size_t checksum = 0;
+
+    for (int x : keys) timeOperation(insert, [&] { tree.insert(x); });
+    std::shuffle(keys.begin(), keys.end(), g);
+    for (int x : keys) timeOperation(search, [&] { checksum += tree.search(x); });
+    std::shuffle(keys.begin(), keys.end(), g);
+    for (size_t i = 0; i < keys.size() / 2; ++i) timeOperation(remove, [&] { tree.remove(keys[i]); });
+    while (!tree.empty()) timeOperation(removeMin, [&] { checksum += static_cast<size_t>(tree.removeMin()); });
+    benchmarkSink = checksum;
+
+    return {name, {{"insert", insert}, {"search", search}, {"remove", remove}, {"removeMin", removeMin}}};
+}
+
+// Tail latencies per operation and tree type, the averages above hide rebalancing spikes
+void benchmarkLatency(bool json) {
+    const int N = 200000;
+    std::vector<int> data(N);
+    std::iota(data.begin(), data.end(), 1);
+    std::mt19937 g(29);
+    std::shuffle(data.begin(), data.end(), g);
+
+    std::vector<LatencyReport> reports;
+    {
+        adsc::BinaryTree<int> tree;
+        reports.push_back(measureLatency("BinaryTree", tree, data));
+    }
+    {
+        adsc::AVLTree<int> tree;
+        reports.push_back(measureLatency("AVLTree", tree, data));
+    }
+    {
+        adsc::AVLTree<int> tree;
+        tree.setLazyRemoval(true);
+        reports.push_back(measureLatency("AVLTree lazy", tree, data));
+    }
+    {
+        adsc::SkipList<int> tree;
+        reports.push_back(measureLatency("SkipList", tree, data));
+    }
+
+    if (json) {
+        std::cout << std::defaultfloat << "{\"unit\": \"ns\", \"n\": " << N << ", \"trees\": {";
+        for (size_t t = 0; t < reports.size(); ++t) {
+            std::cout << (t ? ", " : "") << "\"" << reports[t].tree << "\": {";
+            for (size_t o = 0; o < reports[t].operations.size(); ++o) {
+                std::cout << (o ? ", " : "") << "\"" << reports[t].operations[o].first << "\": ";
+                reports[t].operations[o].second.printJson(std::cout);
+            }
+            std::cout << "}";
+        }
+        std::cout << "}}" << std::endl;
+        return;
+    }
+
+    std::cout << "\n" << std::string(70, '=') << "\n";
+    std::cout << "  OPERATION LATENCY (ns, N = " << N << ")\n";
+    std::cout << std::string(70, '=') << "\n";
+    std::cout << std::left << std::setw(16) << "Structure"
+              << std::setw(12) << "Operation"
+              << std::setw(10) << "p50"
+              << std::setw(10) << "p99"
+              << std::setw(10) << "p99.9"
+              << std::setw(12) << "max" << std::endl;
+    std::cout << std::string(70, '-') << std::endl;
+    for (const auto& report : reports) {
+        for (const auto& operation : report.operations) {
+            const adsc::LatencyHistogram& histogram = operation.second;
+            std::cout << std::left << std::setw(16) << report.tree
+                      << std::setw(12) << operation.first
+                      << std::setw(10) << histogram.valueAtPercentile(50.0)
+                      << std::setw(10) << histogram.valueAtPercentile(99.0)
+                      << std::setw(10) << histogram.valueAtPercentile(99.9)
+                      << std::setw(12) << histogram.max() << std::endl;
+        }
+    }
+}
+
+// Ingest rate with the write-behind buffer, and the latency of reading back a fresh write
+void benchmarkBufferedIngest() {
+    const int N = 1000000;
+    const int readEvery = 64;
+    std::vector<int> data(N);
+    std::mt19937 g(43);
+    for (int& x : data) x = static_cast<int>(g() % (4 * N));
+
+    std::cout << "\n" << std::string(70, '=') << "\n";
+    std::cout << "  WRITE-BEHIND INGEST (N = " << N << ", read back every " << readEvery << "th write, ns)\n";
+    std::cout << std::string(70, '=') << "\n";
+    std::cout << std::left << std::setw(27) << "Structure"
+              << std::setw(15) << "Ingest Mops/s"
+              << std::setw(10) << "Read p50"
+              << std::setw(10) << "Read p99"
+              << std::setw(10) << "Read p99.9" << std::endl;
+    std::cout << std::string(70, '-') << std::endl;
+
+    auto run = [&](const std::string& name, auto& tree, auto&& finish) {
+        adsc::LatencyHistogram reads;
+        size_t hits = 0;
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < N; ++i) {
+            tree.insert(data[i]);
+            if (i % readEvery == 0) timeOperation(reads, [&] { hits += tree.search(data[i]); });
+        }
+        finish(tree);
+        auto end = std::chrono::high_resolution_clock::now();
+        benchmarkSink = hits;
+
+        double seconds = std::chrono::duration<double>(end - start).count();
+        std::cout << std::left << std::setw(27) << name
+                  << std::setw(15) << N / seconds / 1e6
+                  << std::setw(10) << reads.valueAtPercentile(50.0)
+                  << std::setw(10) << reads.valueAtPercentile(99.0)
+                  << std::setw(10) << reads.valueAtPercentile(99.9) << std::endl;
+    };
+
+    {
+        adsc::AVLTree<int> tree;
+        run("AVLTree", tree, [](adsc::AVLTree<int>&) {});
+    }
+    auto flush = [](adsc::BufferedTree<int>& tree) { tree.flush(); };
+    for (size_t capacity : {64, 1024, 16384}) {
+        adsc::BufferedTree<int> tree(capacity);
+        run("Buffered inline " + std::to_string(capacity), tree, flush);
+    }
+    {
+        adsc::BufferedTree<int> tree(1024, adsc::MergeMode::Background);
+        run("Buffered background 1024", tree, flush);
+    }
+}
+
+// Insert, lookup and ordered drain of one key set through any multiset-like container
+template<typename Key, typename Insert, typename Search, typename Drain>
+void timeKeySet(const std::string& name, const std::vector<Key>& keys, const std::vector<Key>& probes,
+                Insert&& insert, Search&& search, Drain&& drain) {
+    auto start = std::chrono::high_resolution_clock::now();
+    for (const Key& key : keys) insert(key);
+    auto inserted = std::chrono::high_resolution_clock::now();
+    size_t hits = 0;
+    for (const Key& key : probes) hits += search(key);
+    auto searched = std::chrono::high_resolution_clock::now();
+    drain();
+    auto end = std::chrono::high_resolution_clock::now();
+    benchmarkSink = hits;
+
+    std::cout << std::left << std::setw(18) << name
+              << std::setw(14) << std::chrono::duration<double>(inserted - start).count()
+              << std::setw(14) << std::chrono::duration<double>(searched - inserted).count()
+              << std::setw(14) << std::chrono::duration<double>(end - searched).count() << std::endl;
+}
+
+template<typename Key>
+void compareRadix(const std::string& title, const std::vector<Key>& keys) {
+    std::vector<Key> probes(keys);
+    std::mt19937 g(47);
+    std::shuffle(probes.begin(), probes.end(), g);
+
+    std::cout << "\n" << std::string(60, '=') << "\n";
+    std::cout << "  " << title << " (N = " << keys.size() << ")\n";
+    std::cout << std::string(60, '=') << "\n";
+    std::cout << std::left << std::setw(18) << "Structure"
+              << std::setw(14) << "Insert (s)"
+              << std::setw(14) << "Search (s)"
+              << std::setw(14) << "RemoveMin (s)" << std::endl;
+    std::cout << std::string(60, '-') << std::endl;
+
+    {
+        adsc::RadixTree<Key> tree;
+        timeKeySet("RadixTree", keys, probes, [&](const Key& k) { tree.insert(k); },
+                   [&](const Key& k) { return tree.search(k); }, [&] { while (!tree.empty()) tree.removeMin(); });
+    }
+    {
+        adsc::AVLTree<Key> tree;
+        timeKeySet("AVLTree", keys, probes, [&](const Key& k) { tree.insert(k); },
+                   [&](const Key& k) { return tree.search(k); }, [&] { while (!tree.empty()) tree.removeMin(); });
+    }
+    {
+        std::multiset<Key> tree;
+        timeKeySet("std::multiset", keys, probes, [&](const Key& k) { tree.insert(k); },
+                   [&](const Key& k) { return tree.count(k) > 0; }, [&] { while (!tree.empty()) tree.erase(tree.begin()); });
+    }
+}
+
+// Radix descent against comparisons, on random 64-bit integers and URL-like strings
+void benchmarkRadix() {
+    std::mt19937_64 g(53);
+    std::vector<uint64_t> integers(1000000);
+    for (uint64_t& x : integers) x = g();
+    compareRadix("64-BIT INTEGER KEYS", integers);
+
+    // Few hosts and shared path segments, the long common prefixes of real URL sets
+    const std::array<const char*, 6> hosts = {"https://www.example.com", "https://api.example.com",
+                                              "https://cdn.example.net", "http://shop.example.org",
+                                              "https://docs.example.io", "https://news.example.co.uk"};
+    const std::array<const char*, 8> sections = {"/products", "/users", "/static/js", "/static/css",
+                                                 "/api/v2/items", "/blog/2024", "/search", "/category/books"};
+    std::vector<std::string> urls(500000);
+    for (std::string& url : urls) {
+        url = std::string(hosts[g() % hosts.size()]) + sections[g() % sections.size()] + "/" + std::to_string(g() % 1000000);
+        if (g() % 3 == 0) url += "?page=" + std::to_string(g() % 50);
+    }
+    compareRadix("URL KEYS", urls);
+}
+
 void printHeader(const std::string& title, int N) {
     std::cout << "\n" << std::string(60, '=') << "\n";
     std::cout << "  " << title << " (N = " << N << ")\n";
@@ -87,7 +1210,283 @@ void printRow(const std::string& name, BenchResult res) {
     std::cout << std::endl;
 }
 
-int main() {
+// Heap bytes currently in use, malloc headers included. Only known with glibc's mallinfo2
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || __GLIBC_MINOR__ >= 33)
+constexpr bool kHeapBytesKnown = true;
+size_t heapBytesInUse() {
+    struct mallinfo2 info = mallinfo2();
+    return info.uordblks + info.hblkhd;
+}
+#else
+constexpr bool kHeapBytesKnown = false;
+size_t heapBytesInUse() { return 0; }
+#endif
+
+enum class Workload { Insert, Lookup, Drain, Mixed };
+
+const char* workloadName(Workload workload) {
+    switch (workload) {
+        case Workload::Insert: return "insert";
+        case Workload::Lookup: return "lookup";
+        case Workload::Drain: return "drain";
+        default: return "mixed";
+    }
+}
+
+// Uniform interface of the matrix contestants. supports() leaves out what a container
+// cannot do, or only in O(n) per operation past a size where that would take hours
+struct MatrixAVLTree {
+    static constexpr const char* name = "AVLTree";
+    static bool supports(Workload, size_t) { return true; }
+    void load(const std::vector<int>& keys) { for (int k : keys) c.insert(k); }
+    void insert(int k) { c.insert(k); }
+    void remove(int k) { c.remove(k); }
+    bool contains(int k) const { return c.search(k); }
+    int removeMin() { return c.removeMin(); }
+    bool empty() const { return c.empty(); }
+    adsc::AVLTree<int> c;
+};
+
+struct MatrixMultiset {
+    static constexpr const char* name = "std::multiset";
+    static bool supports(Workload, size_t) { return true; }
+    void load(const std::vector<int>& keys) { for (int k : keys) c.insert(k); }
+    void insert(int k) { c.insert(k); }
+    void remove(int k) { auto it = c.find(k); if (it != c.end()) c.erase(it); }
+    bool contains(int k) const { return c.count(k) > 0; }
+    int removeMin() { int k = *c.begin(); c.erase(c.begin()); return k; }
+    bool empty() const { return c.empty(); }
+    std::multiset<int> c;
+};
+
+// Key to multiplicity, one node per distinct key like AVLTree
+struct MatrixMap {
+    static constexpr const char* name = "std::map";
+    static bool supports(Workload, size_t) { return true; }
+    void load(const std::vector<int>& keys) { for (int k : keys) c[k]++; }
+    void insert(int k) { c[k]++; }
+    void remove(int k) { auto it = c.find(k); if (it != c.end() && --it->second == 0) c.erase(it); }
+    bool contains(int k) const { return c.count(k) > 0; }
+    int removeMin() { auto it = c.begin(); int k = it->first; if (--it->second == 0) c.erase(it); return k; }
+    bool empty() const { return c.empty(); }
+    std::map<int, uint64_t> c;
+};
+
+// Bulk loaded by one sort, point updates shift the tail. Kept in descending order so
+// the minimum comes off the back. Inserting key by key is O(n^2), like the mixed
+// workload only run while that takes seconds
+struct MatrixSortedVector {
+    static constexpr const char* name = "sorted vector";
+    static bool supports(Workload workload, size_t n) {
+        return (workload != Workload::Insert && workload != Workload::Mixed) || n <= 100000;
+    }
+    void load(const std::vector<int>& keys) { c = keys; std::sort(c.begin(), c.end(), std::greater<int>()); }
+    void insert(int k) { c.insert(std::upper_bound(c.begin(), c.end(), k, std::greater<int>()), k); }
+    void remove(int k) {
+        auto it = std::lower_bound(c.begin(), c.end(), k, std::greater<int>());
+        if (it != c.end() && *it == k) c.erase(it);
+    }
+    bool contains(int k) const { return std::binary_search(c.begin(), c.end(), k, std::greater<int>()); }
+    int removeMin() { int k = c.back(); c.pop_back(); return k; }
+    bool empty() const { return c.empty(); }
+    std::vector<int> c;
+};
+
+struct MatrixPriorityQueue {
+    static constexpr const char* name = "std::priority_queue";
+    static bool supports(Workload workload, size_t) { return workload == Workload::Insert || workload == Workload::Drain; }
+    void load(const std::vector<int>& keys) { for (int k : keys) c.push(k); }
+    void insert(int k) { c.push(k); }
+    void remove(int) {}
+    bool contains(int) const { return false; }
+    int removeMin() { int k = c.top(); c.pop(); return k; }
+    bool empty() const { return c.empty(); }
+    std::priority_queue<int, std::vector<int>, std::greater<int>> c;
+};
+
+struct MatrixHashSet {
+    static constexpr const char* name = "std::unordered_multiset";
+    static bool supports(Workload workload, size_t) { return workload != Workload::Drain; }
+    void load(const std::vector<int>& keys) { for (int k : keys) c.insert(k); }
+    void insert(int k) { c.insert(k); }
+    void remove(int k) { auto it = c.find(k); if (it != c.end()) c.erase(it); }
+    bool contains(int k) const { return c.count(k) > 0; }
+    int removeMin() { return 0; }
+    bool empty() const { return c.empty(); }
+    std::unordered_multiset<int> c;
+};
+
+struct MatrixCell {
+    double opsPerSecond;
+    // NaN where the heap usage is unknown
+    double bytesPerKey;
+};
+
+// Runs one workload on a fresh container holding keys, the operations timed are n
+// inserts one key at a time, n lookups (half of them misses), n removeMin or n mixed
+// operations. The other workloads start from load(), which may bulk load
+template<typename Container>
+MatrixCell measureMatrixCell(Workload workload, const std::vector<int>& keys, const std::vector<int>& probes) {
+    size_t heapBefore = heapBytesInUse();
+    auto bytesPerKey = [&] {
+        return kHeapBytesKnown ? static_cast<double>(heapBytesInUse() - heapBefore) / keys.size()
+                               : std::numeric_limits<double>::quiet_NaN();
+    };
+    auto container = std::make_unique<Container>();
+    auto start = std::chrono::high_resolution_clock::now();
+    if (workload == Workload::Insert) {
+        for (int key : keys) container->insert(key);
+        auto end = std::chrono::high_resolution_clock::now();
+        return {keys.size() / std::chrono::duration<double>(end - start).count(), bytesPerKey()};
+    }
+
+    container->load(keys);
+    double loadedBytesPerKey = bytesPerKey();
+    size_t hits = 0;
+    start = std::chrono::high_resolution_clock::now();
+    switch (workload) {
+        case Workload::Lookup:
+            for (int key : probes) hits += container->contains(key);
+            break;
+        case Workload::Drain:
+            // The removed keys are consumed, as a drain would
+            while (!container->empty()) hits += static_cast<size_t>(container->removeMin());
+            break;
+        default:
+            // 50% lookups, 25% inserts, 25% removals
+            for (size_t i = 0; i < probes.size(); ++i) {
+                int key = probes[i];
+                switch (i & 3) {
+                    case 0: container->insert(key); break;
+                    case 1: container->remove(key); break;
+                    default: hits += container->contains(key);
+                }
+            }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    benchmarkSink = hits;
+    return {probes.size() / std::chrono::duration<double>(end - start).count(), loadedBytesPerKey};
+}
+
+struct MatrixRow {
+    Workload workload;
+    size_t n;
+    std::string container;
+    MatrixCell cell;
+};
+
+template<typename Container>
+void addMatrixRow(std::vector<MatrixRow>& rows, Workload workload, const std::vector<int>& keys, const std::vector<int>& probes) {
+    if (Container::supports(workload, keys.size())) {
+        rows.push_back({workload, keys.size(), Container::name, measureMatrixCell<Container>(workload, keys, probes)});
+    }
+}
+
+// Every workload against every container that supports it, N = 1K, 10K, ... maxN.
+// Prints one ops/s table per workload plus bytes per key, or CSV rows only
+void benchmarkMatrix(size_t maxN, bool csv) {
+    const std::vector<std::string> containers = {MatrixAVLTree::name, MatrixMultiset::name, MatrixMap::name,
+                                                 MatrixSortedVector::name, MatrixPriorityQueue::name, MatrixHashSet::name};
+    std::vector<MatrixRow> rows;
+    for (size_t n = 1000; n <= maxN; n *= 10) {
+        std::mt19937 g(static_cast<uint32_t>(n));
+        std::vector<int> keys(n);
+        for (int& key : keys) key = static_cast<int>(g() >> 1);
+        // Half the probes hit, the other half are random and almost always miss
+        std::vector<int> probes(n);
+        for (size_t i = 0; i < n; ++i) probes[i] = i % 2 ? keys[g() % n] : static_cast<int>(g() >> 1);
+
+        for (Workload workload : {Workload::Insert, Workload::Lookup, Workload::Drain, Workload::Mixed}) {
+            addMatrixRow<MatrixAVLTree>(rows, workload, keys, probes);
+            addMatrixRow<MatrixMultiset>(rows, workload, keys, probes);
+            addMatrixRow<MatrixMap>(rows, workload, keys, probes);
+            addMatrixRow<MatrixSortedVector>(rows, workload, keys, probes);
+            addMatrixRow<MatrixPriorityQueue>(rows, workload, keys, probes);
+            addMatrixRow<MatrixHashSet>(rows, workload, keys, probes);
+        }
+    }
+
+    if (csv) {
+        std::cout << "workload,container,n,ops_per_sec,bytes_per_key" << std::endl;
+        for (const MatrixRow& row : rows) {
+            std::cout << workloadName(row.workload) << "," << row.container << "," << row.n << ","
+                      << std::fixed << std::setprecision(0) << row.cell.opsPerSecond << ",";
+            if (std::isnan(row.cell.bytesPerKey)) std::cout << "n/a" << std::endl;
+            else std::cout << std::setprecision(1) << row.cell.bytesPerKey << std::endl;
+        }
+        return;
+    }
+
+    // Mops/s per workload, then the footprint after loading
+    auto table = [&](const std::string& title, auto select, auto value) {
+        // Wide enough for the longest container name
+        const int column = 25;
+        const int width = 14 + column * static_cast<int>(containers.size());
+        std::cout << "\n" << std::string(width, '=') << "\n";
+        std::cout << "  " << title << "\n";
+        std::cout << std::string(width, '=') << "\n";
+        std::cout << std::left << std::setw(14) << "N";
+        for (const std::string& container : containers) {
+            std::cout << std::setw(column) << container;
+        }
+        std::cout << "\n" << std::string(width, '-') << std::endl;
+        for (size_t n = 1000; n <= maxN; n *= 10) {
+            std::cout << std::left << std::setw(14) << n;
+            for (const std::string& container : containers) {
+                auto it = std::find_if(rows.begin(), rows.end(), [&](const MatrixRow& row) {
+                    return row.n == n && row.container == container && select(row);
+                });
+                std::ostringstream cell;
+                if (it == rows.end()) cell << "-";
+                else if (std::isnan(value(*it))) cell << "n/a";
+                else cell << std::fixed << std::setprecision(2) << value(*it);
+                std::cout << std::setw(column) << cell.str();
+            }
+            std::cout << std::endl;
+        }
+    };
+    for (Workload workload : {Workload::Insert, Workload::Lookup, Workload::Drain, Workload::Mixed}) {
+        table(std::string("MATRIX: ") + workloadName(workload) + " (Mops/s)",
+              [workload](const MatrixRow& row) { return row.workload == workload; },
+              [](const MatrixRow& row) { return row.cell.opsPerSecond / 1e6; });
+    }
+    // Every workload records the footprint after loading, the first one run is shown
+    table("MATRIX: heap bytes per key after loading",
+          [](const MatrixRow&) { return true; },
+          [](const MatrixRow& row) { return row.cell.bytesPerKey; });
+}
+
+int main(int argc, char** argv) {
+    bool latency = false;
+    bool json = false;
+    bool matrix = false;
+    bool csv = false;
+    size_t maxN = 1000000;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--latency") latency = true;
+        else if (arg == "--json") json = true;
+        else if (arg == "--matrix") matrix = true;
+        else if (arg == "--csv") csv = true;
+        else if (arg == "--max-n" && i + 1 < argc) maxN = std::strtoull(argv[++i], nullptr, 10);
+        else {
+            std::cerr << "usage: " << argv[0] << " [--latency [--json]] [--matrix [--csv] [--max-n N]]" << std::endl;
+            return 1;
+        }
+    }
+
+    // Per-operation tail latencies only
+    if (latency) {
+        benchmarkLatency(json);
+        return 0;
+    }
+
+    // Container comparison matrix only
+    if (matrix) {
+        benchmarkMatrix(maxN, csv);
+        return 0;
+    }
+
     std::cout << std::fixed << std::setprecision(6);
 
     // --- RANDOM DATA ---
@@ -117,6 +1516,67 @@ int main() {
         printRow("std::multiset", measureMultiset(data));
     }
 
+    // --- DUPLICATE-HEAVY DATA ---
+    {
+        const int N = 100000;
+        std::vector<int> data(N);
+        std::mt19937 g(7);
+        for (int& x : data) x = static_cast<int>(g() % 100);
+
+        printHeader("DUPLICATE KEYS, 100 DISTINCT", N);
+        printRow("BinaryTree", measure<adsc::BinaryTree<int>>(data));
+        printRow("AVLTree", measure<adsc::AVLTree<int>>(data));
+        printRow("std::multiset", measureMultiset(data));
+    }
+
+    // --- LARGE KEYS, NODE LAYOUTS ---
+    benchmarkLargeKeys<64>(500000);
+    benchmarkLargeKeys<256>(200000);
+
+    // --- HISTOGRAM, BULK COUNTS ---
+    benchmarkHistogram();
+
+    // --- NEARLY SORTED INSERTS ---
+    benchmarkNearlySorted();
+
+    // --- BATCHED LOOKUPS ---
+    benchmarkBatchSearch();
+
+    // --- HUGE PAGES ---
+    benchmarkHugePages();
+
+    // --- RADIX KEYS ---
+    benchmarkRadix();
+
+    // --- FROZEN LOOKUPS, LEARNED INDEX ---
+    benchmarkLearnedIndex();
+
+    // --- ORDERED DRAIN ---
+    benchmarkDrain();
+
+    // --- BURST DELETES ---
+    benchmarkLazyRemoval();
+
+    // --- INTERVAL OVERLAP ---
+    benchmarkIntervals();
+
+    // --- STATIC VS VIRTUAL DISPATCH ---
+    benchmarkDispatch();
+
+    // --- COMPILE-TIME LOOKUP TABLE ---
+    benchmarkStaticTable();
+
+    // --- CONCURRENT MIXED WORKLOAD ---
+    benchmarkThreadScaling();
+    benchmarkReadChurn();
+    benchmarkReadScaling();
+
+    // --- TAIL LATENCY ---
+    benchmarkLatency(false);
+
+    // --- WRITE-BEHIND INGEST ---
+    benchmarkBufferedIngest();
+
     std::cout << std::string(60, '=') << std::endl;
     return 0;
 }
\ No newline at end of file
@@ -1,7 +1,11 @@
 #include <gtest/gtest.h>
 #include "AVLTree.hpp"
 
+#include <algorithm>
+#include <iterator>
+#include <limits>
 #include <queue>
+#include <type_traits>
 #include <vector>
 
 using adsc::AVLTree;
@@ -162,4 +166,371 @@ TEST_F(AVLTreeTest, CompareWithPriorityQueue) {
 
     EXPECT_TRUE(avl.empty());
     EXPECT_TRUE(pq.empty());
-}
\ No newline at end of file
+}
+
+TEST_F(AVLTreeTest, MinMaxFollowRotationsAndRemovals) {
+    EXPECT_THROW(avl.min(), std::runtime_error);
+
+    for (int x : {40, 20, 60, 10, 30, 50, 70, 10}) avl.insert(x);
+    EXPECT_EQ(avl.min(), 10);
+    EXPECT_EQ(avl.max(), 70);
+
+    EXPECT_EQ(avl.removeMin(), 10);
+    EXPECT_EQ(avl.min(), 10);
+    EXPECT_EQ(avl.nodesCount(), 7);
+
+    EXPECT_EQ(avl.removeMin(), 10);
+    EXPECT_EQ(avl.min(), 20);
+
+    avl.remove(70);
+    EXPECT_EQ(avl.max(), 60);
+    avl.remove(20);
+    EXPECT_EQ(avl.min(), 30);
+
+    avl.insert(5);
+    avl.insert(99);
+    EXPECT_EQ(avl.min(), 5);
+    EXPECT_EQ(avl.max(), 99);
+
+    while (avl.elementsCount() > 1) {
+        int before = avl.max();
+        EXPECT_EQ(avl.removeMax(), before);
+    }
+    EXPECT_EQ(avl.min(), avl.max());
+    avl.removeMin();
+    EXPECT_THROW(avl.max(), std::runtime_error);
+}
+
+TEST_F(AVLTreeTest, LazyRemovalLeavesTombstones) {
+    avl.setLazyRemoval(true, 0.5);
+    for (int x : {50, 25, 75, 10, 30, 60, 90}) avl.insert(x);
+
+    avl.remove(25);
+    avl.remove(60);
+
+    EXPECT_EQ(avl.tombstonesCount(), 2);
+    EXPECT_EQ(avl.nodesCount(), 7);
+    EXPECT_EQ(avl.elementsCount(), 5);
+    EXPECT_FALSE(avl.search(25));
+    EXPECT_TRUE(avl.search(30));
+
+    // Re-inserting revives the tombstone in place
+    avl.insert(25);
+    EXPECT_EQ(avl.tombstonesCount(), 1);
+    EXPECT_EQ(avl.nodesCount(), 7);
+    EXPECT_TRUE(avl.search(25));
+
+    avl.remove(60);
+    EXPECT_EQ(avl.elementsCount(), 6);
+}
+
+TEST_F(AVLTreeTest, LazyRemovalKeepsExtremesLive) {
+    avl.setLazyRemoval(true, 1.0);
+    for (int x : {40, 20, 60, 10, 30, 50, 70}) avl.insert(x);
+
+    avl.remove(20);
+    avl.remove(30);
+    EXPECT_EQ(avl.tombstonesCount(), 2);
+
+    // Removing the minimum also purges the tombstones that become leftmost
+    avl.remove(10);
+    EXPECT_EQ(avl.min(), 40);
+    EXPECT_EQ(avl.tombstonesCount(), 0);
+    EXPECT_EQ(avl.nodesCount(), 4);
+
+    avl.remove(60);
+    EXPECT_EQ(avl.removeMax(), 70);
+    EXPECT_EQ(avl.max(), 50);
+    EXPECT_EQ(avl.tombstonesCount(), 0);
+    EXPECT_EQ(avl.removeMin(), 40);
+    EXPECT_EQ(avl.removeMin(), 50);
+    EXPECT_TRUE(avl.empty());
+}
+
+TEST_F(AVLTreeTest, CompactionRebuildsBalancedTree) {
+    avl.setLazyRemoval(true, 0.3);
+    for (int x = 1; x <= 100; ++x) avl.insert(x);
+
+    for (int x = 2; x < 100; x += 2) avl.remove(x);
+
+    EXPECT_LT(avl.tombstonesCount(), 0.3 * avl.nodesCount() + 1);
+    EXPECT_EQ(avl.elementsCount(), 51);
+
+    avl.setLazyRemoval(false);
+    EXPECT_EQ(avl.tombstonesCount(), 0);
+    EXPECT_EQ(avl.nodesCount(), 51);
+    EXPECT_LE(avl.getRoot()->getHeight(), 6);
+    EXPECT_EQ(avl.getRoot()->getNodeBalance(), 0);
+
+    for (int x = 1; x <= 100; x += 2) {
+        EXPECT_EQ(avl.removeMin(), x);
+    }
+    EXPECT_EQ(avl.removeMin(), 100);
+    EXPECT_TRUE(avl.empty());
+}
+
+TEST_F(AVLTreeTest, CopyKeepsShapeTombstonesAndExtremes) {
+    avl.setLazyRemoval(true, 1.0);
+    for (int x = 1; x <= 20; ++x) avl.insert(x, 2);
+    avl.remove(1, 2);
+    avl.remove(7, 2);
+
+    AVLTree<int> copy(avl);
+    EXPECT_EQ(copy.nodesCount(), avl.nodesCount());
+    EXPECT_EQ(copy.elementsCount(), avl.elementsCount());
+    EXPECT_EQ(copy.tombstonesCount(), avl.tombstonesCount());
+    EXPECT_EQ(copy.getRoot()->getHeight(), avl.getRoot()->getHeight());
+    EXPECT_EQ(copy.min(), 2);
+    EXPECT_EQ(copy.max(), 20);
+
+    // The copy owns its nodes
+    avl.remove(2, 2);
+    copy.remove(20, 2);
+    EXPECT_EQ(copy.min(), 2);
+    EXPECT_EQ(avl.max(), 20);
+    EXPECT_EQ(copy.extractAll().size(), 34u);
+    EXPECT_EQ(avl.elementsCount(), 34u);
+}
+
+TEST_F(AVLTreeTest, MoveTakesNodesAndLeavesSourceEmpty) {
+    avl.setLazyRemoval(true, 1.0);
+    for (int x = 1; x <= 20; ++x) avl.insert(x);
+    avl.remove(1);
+    avl.remove(7);
+    const auto* root = avl.getRoot().get();
+
+    AVLTree<int> moved(std::move(avl));
+    EXPECT_EQ(moved.getRoot().get(), root);
+    EXPECT_EQ(moved.elementsCount(), 18u);
+    EXPECT_EQ(moved.tombstonesCount(), 1u);
+    EXPECT_EQ(moved.min(), 2);
+    EXPECT_EQ(moved.max(), 20);
+
+    // The source stays usable
+    EXPECT_TRUE(avl.empty());
+    EXPECT_EQ(avl.nodesCount(), 0u);
+    EXPECT_EQ(avl.tombstonesCount(), 0u);
+    avl.insert(5);
+    EXPECT_EQ(avl.min(), 5);
+
+    avl = std::move(moved);
+    EXPECT_EQ(avl.getRoot().get(), root);
+    EXPECT_EQ(avl.removeMin(), 2);
+    EXPECT_EQ(avl.removeMax(), 20);
+    EXPECT_TRUE(moved.empty());
+    moved.insert(3);
+    EXPECT_EQ(moved.max(), 3);
+
+    static_assert(std::is_nothrow_move_constructible_v<AVLTree<int>>);
+}
+
+TEST(AVLTreeAugmentationTest, RangeSumFollowsRotations) {
+    AVLTree<long, std::less<long>, adsc::SumAugmentation<long>> tree;
+    for (long x = 1; x <= 100; ++x) tree.insert(x);
+    tree.insert(50);
+
+    EXPECT_EQ(tree.aggregate(), 5050 + 50);
+    EXPECT_EQ(tree.rangeAggregate(1, 10), 55);
+    EXPECT_EQ(tree.rangeAggregate(50, 50), 100);
+    EXPECT_EQ(tree.rangeAggregate(95, 1000), 95 + 96 + 97 + 98 + 99 + 100);
+    EXPECT_EQ(tree.rangeAggregate(200, 300), 0);
+
+    tree.remove(50);
+    EXPECT_EQ(tree.rangeAggregate(50, 50), 50);
+    tree.remove(50);
+    EXPECT_EQ(tree.rangeAggregate(49, 51), 100);
+
+    EXPECT_EQ(tree.removeMin(), 1);
+    EXPECT_EQ(tree.removeMax(), 100);
+    EXPECT_EQ(tree.aggregate(), 5050 - 50 - 1 - 100);
+}
+
+TEST(AVLTreeAugmentationTest, IntSumsAccumulateIn64Bits) {
+    AVLTree<int, std::less<int>, adsc::SumAugmentation<int>> tree;
+    static_assert(std::is_same_v<adsc::SumAugmentation<int>::value_type, int64_t>, "64-bit accumulator");
+    const int big = std::numeric_limits<int>::max() - 5;
+    int64_t expected = 0;
+    for (int i = 0; i < 5; ++i) {
+        tree.insert(big + i, 3);
+        expected += 3 * static_cast<int64_t>(big + i);
+    }
+    EXPECT_EQ(tree.aggregate(), expected);
+    EXPECT_EQ(tree.rangeAggregate(big + 1, big + 2), 3 * (static_cast<int64_t>(big) * 2 + 3));
+}
+
+TEST(AVLTreeAugmentationTest, RangeMaxMatchesScan) {
+    AVLTree<int, std::less<int>, adsc::MaxAugmentation<int>> tree;
+    tree.setLazyRemoval(true, 0.5);
+    std::vector<int> values;
+    for (int i = 0; i < 200; ++i) {
+        int x = (i * 37) % 211;
+        tree.insert(x);
+        values.push_back(x);
+    }
+    for (int i = 0; i < 200; i += 3) {
+        tree.remove(values[i]);
+        values[i] = -1;
+    }
+
+    for (int lo = 0; lo < 211; lo += 13) {
+        for (int hi = lo; hi < 211; hi += 29) {
+            int expected = std::numeric_limits<int>::lowest();
+            for (int x : values) {
+                if (x >= lo && x <= hi) expected = std::max(expected, x);
+            }
+            EXPECT_EQ(tree.rangeAggregate(lo, hi), expected) << lo << ".." << hi;
+        }
+    }
+}
+
+// Comparator counting its calls, shared between copies
+struct CountingLess {
+    size_t* calls;
+    bool operator()(int a, int b) const { ++*calls; return a < b; }
+};
+
+TEST(AVLTreeHintTest, SortedInsertCostsConstantComparisons) {
+    const int N = 1 << 14;
+    size_t hinted = 0;
+    size_t plain = 0;
+    AVLTree<int, CountingLess> fingerTree(CountingLess{&hinted});
+    AVLTree<int, CountingLess> plainTree(CountingLess{&plain});
+    fingerTree.setFingerSearch(true);
+
+    for (int x = 0; x < N; ++x) {
+        fingerTree.insert(x);
+        plainTree.insert(x);
+    }
+
+    EXPECT_LE(hinted, 4u * N);
+    EXPECT_GT(plain, 10u * N);
+    EXPECT_EQ(fingerTree.getRoot()->getHeight(), plainTree.getRoot()->getHeight());
+    EXPECT_EQ(fingerTree.min(), 0);
+    EXPECT_EQ(fingerTree.max(), N - 1);
+}
+
+TEST_F(AVLTreeTest, HintedInsertKeepsOrderAndCounts) {
+    std::priority_queue<int, std::vector<int>, std::greater<int>> pq;
+    const adsc::InsertHint hints[] = {adsc::InsertHint::None, adsc::InsertHint::NearMin, adsc::InsertHint::NearMax};
+
+    // Nearly sorted with duplicates and keys on both sides of the root
+    for (int i = 0; i < 3000; ++i) {
+        int x = (i % 7 == 0) ? 3000 - i : i + (i % 5);
+        avl.insert(hints[i % 3], x);
+        pq.push(x);
+    }
+    EXPECT_EQ(avl.elementsCount(), 3000);
+    EXPECT_LE(avl.getRoot()->getHeight(), 15);
+
+    while (!pq.empty()) {
+        EXPECT_EQ(avl.removeMin(), pq.top());
+        pq.pop();
+    }
+    EXPECT_TRUE(avl.empty());
+}
+
+TEST_F(AVLTreeTest, SearchBatchMatchesSearch) {
+    avl.setLazyRemoval(true, 0.9);
+    for (int x = 0; x < 2000; x += 3) avl.insert(x);
+    for (int x = 0; x < 2000; x += 9) avl.remove(x);
+    ASSERT_GT(avl.tombstonesCount(), 0u);
+
+    std::vector<int> keys;
+    for (int x = -5; x < 2005; ++x) keys.push_back((x * 7919) % 2010);
+
+    std::vector<bool> results;
+    avl.searchBatch(keys, results);
+    ASSERT_EQ(results.size(), keys.size());
+    for (size_t i = 0; i < keys.size(); ++i) {
+        EXPECT_EQ(results[i], avl.search(keys[i])) << "key " << keys[i];
+    }
+
+    AVLTree<int> emptyTree;
+    std::vector<char> none;
+    emptyTree.searchBatch(keys, none);
+    EXPECT_EQ(std::count(none.begin(), none.end(), 1), 0);
+}
+
+TEST_F(AVLTreeTest, BulkCountsBehaveLikeRepeatedOperations) {
+    avl.insert(10, 1000000);
+    avl.insert(20, 5);
+    avl.insert(5, 0);
+    EXPECT_EQ(avl.nodesCount(), 2);
+    EXPECT_EQ(avl.elementsCount(), 1000005u);
+    EXPECT_FALSE(avl.search(5));
+
+    EXPECT_EQ(avl.remove(10, 400000), 400000u);
+    EXPECT_EQ(avl.remove(30, 1), 0u);
+    EXPECT_EQ(avl.remove(20, 100), 5u);
+    EXPECT_FALSE(avl.search(20));
+    EXPECT_EQ(avl.max(), 10);
+
+    auto taken = avl.removeMin(1000);
+    EXPECT_EQ(taken.first, 10);
+    EXPECT_EQ(taken.second, 1000u);
+    taken = avl.removeMax(UINT64_MAX);
+    EXPECT_EQ(taken.second, 599000u);
+    EXPECT_TRUE(avl.empty());
+    EXPECT_THROW(avl.removeMin(1), std::runtime_error);
+}
+
+TEST_F(AVLTreeTest, BulkInsertRejectsOverflow) {
+    avl.insert(1, UINT64_MAX - 1);
+    EXPECT_THROW(avl.insert(2, 2), std::overflow_error);
+    EXPECT_EQ(avl.elementsCount(), UINT64_MAX - 1);
+    EXPECT_EQ(avl.nodesCount(), 1);
+}
+
+TEST(AVLTreeAugmentationTest, RangeSumCountsBulkCopies) {
+    AVLTree<long long, std::less<long long>, adsc::SumAugmentation<long long>> tree;
+    for (long long x = 1; x <= 100; ++x) tree.insert(x, 1000);
+    tree.remove(50, 400);
+    tree.removeMin(999);
+
+    EXPECT_EQ(tree.rangeAggregate(1, 1), 1);
+    EXPECT_EQ(tree.rangeAggregate(50, 50), 50 * 600);
+    EXPECT_EQ(tree.aggregate(), 5050 * 1000 - 50 * 400 - 999);
+}
+
+TEST_F(AVLTreeTest, DrainStreamsInOrderAndEmptiesTree) {
+    avl.setLazyRemoval(true, 0.9);
+    for (int x : {50, 20, 80, 20, 10, 60, 90, 70}) avl.insert(x);
+    avl.insert(30, 3);
+    avl.remove(60);
+    ASSERT_EQ(avl.tombstonesCount(), 1u);
+
+    std::vector<int> out;
+    avl.drain(std::back_inserter(out));
+    EXPECT_EQ(out, (std::vector<int>{10, 20, 20, 30, 30, 30, 50, 70, 80, 90}));
+    EXPECT_TRUE(avl.empty());
+    EXPECT_EQ(avl.nodesCount(), 0u);
+    EXPECT_EQ(avl.elementsCount(), 0u);
+    EXPECT_EQ(avl.tombstonesCount(), 0u);
+    EXPECT_THROW(avl.min(), std::runtime_error);
+
+    // Reusable afterwards
+    for (int x : {3, 1, 2}) avl.insert(x);
+    EXPECT_EQ(avl.extractAll(), (std::vector<int>{1, 2, 3}));
+    EXPECT_TRUE(avl.extractAll().empty());
+}
+
+TEST(AVLTreeDrainTest, MergeDrainInterleavesShards) {
+    std::vector<AVLTree<int>> shards(4);
+    std::vector<int> expected;
+    for (int x = 0; x < 400; ++x) {
+        int key = (x * 37) % 101;
+        shards[x % 4].insert(key);
+        expected.push_back(key);
+    }
+    std::sort(expected.begin(), expected.end());
+
+    std::vector<AVLTree<int>*> trees;
+    for (auto& shard : shards) trees.push_back(&shard);
+    AVLTree<int> emptyShard;
+    trees.push_back(&emptyShard);
+
+    std::vector<int> merged;
+    adsc::mergeDrain(trees, std::back_inserter(merged));
+    EXPECT_EQ(merged, expected);
+    for (auto& shard : shards) EXPECT_TRUE(shard.empty());
+}
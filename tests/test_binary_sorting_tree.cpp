@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+#include "BinarySortingTree.hpp"
+#include "BinaryTree.hpp"
+#include "AVLTree.hpp"
+#include "SkipList.hpp"
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+using adsc::AVLTree;
+using adsc::BinarySortingTree;
+using adsc::BinaryTree;
+using adsc::SkipList;
+using adsc::TreeAdapter;
+
+class TreeAdapterTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        trees.emplace_back(new TreeAdapter<BinaryTree<int>>());
+        trees.emplace_back(new TreeAdapter<AVLTree<int>>());
+        trees.emplace_back(new TreeAdapter<SkipList<int>>());
+    }
+
+    std::vector<std::unique_ptr<BinarySortingTree<int>>> trees;
+};
+
+TEST_F(TreeAdapterTest, ForwardsThroughBaseReference) {
+    for (auto& tree : trees) {
+        BinarySortingTree<int>& base = *tree;
+        EXPECT_TRUE(base.empty());
+        for (int x : {50, 30, 70, 30, 90}) base.insert(x);
+
+        EXPECT_EQ(base.nodesCount(), 4);
+        EXPECT_EQ(base.elementsCount(), 5);
+        EXPECT_TRUE(base.search(70));
+        EXPECT_FALSE(base.search(71));
+
+        base.remove(70);
+        EXPECT_FALSE(base.search(70));
+        EXPECT_EQ(base.removeMin(), 30);
+        EXPECT_EQ(base.removeMax(), 90);
+        EXPECT_EQ(base.removeMin(), 30);
+        EXPECT_EQ(base.removeMin(), 50);
+        EXPECT_TRUE(base.empty());
+        EXPECT_THROW(base.removeMin(), std::runtime_error);
+    }
+}
+
+TEST(TreeAdapter, ExposesWrappedTree) {
+    TreeAdapter<AVLTree<int, std::greater<int>>> adapter(std::greater<int>{});
+    for (int x : {1, 2, 3}) adapter.insert(x);
+
+    EXPECT_EQ(adapter.tree().min(), 3);
+    EXPECT_EQ(adapter.removeMin(), 3);
+}
+
+TEST(SortedTree, InsertAllUsesDerivedInsert) {
+    std::vector<int> data{5, 1, 4, 2, 3};
+    AVLTree<int> tree;
+    tree.insertAll(data.begin(), data.end());
+
+    EXPECT_EQ(tree.elementsCount(), 5);
+    EXPECT_EQ(tree.getRoot()->getHeight(), 3);
+    EXPECT_EQ(tree.min(), 1);
+    EXPECT_EQ(tree.max(), 5);
+}
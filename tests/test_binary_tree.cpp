@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 
 #include <algorithm>
+#include <iterator>
+#include <vector>
 
 #include "BinaryTree.hpp"
 
@@ -164,6 +166,21 @@ TEST_F(BinaryTreeTest, SequentialMinMaxRemoval) {
     EXPECT_TRUE(tree.empty());
 }
 
+TEST_F(BinaryTreeTest, MinMaxTracking) {
+    fillDuplicates();
+    EXPECT_EQ(tree.min(), 20);
+    EXPECT_EQ(tree.max(), 80);
+
+    tree.remove(80);
+    EXPECT_EQ(tree.max(), 50);
+
+    EXPECT_EQ(tree.removeMin(), 20);
+    EXPECT_EQ(tree.min(), 20);
+    EXPECT_EQ(tree.removeMin(), 20);
+    EXPECT_EQ(tree.min(), 50);
+    EXPECT_EQ(tree.max(), 50);
+}
+
 TEST_F(BinaryTreeTest, RemoveRootNode) {
     tree.insert(10);
     tree.insert(20);
@@ -211,6 +228,19 @@ TEST(BinaryTreeGenericTest, StringLengthComparator) {
     EXPECT_EQ(tree.getRoot()->getCount(), 2);
 }
 
+TEST(BinaryTreeGenericTest, MaxFollowsEquivalentInsertions) {
+    BinaryTree<std::string, LengthComparator> tree;
+
+    tree.insert("Foo");
+    tree.insert("Bar");
+
+    // "Bar" is placed right of "Foo", so it is the one removeMax returns
+    EXPECT_EQ(tree.min(), "Foo");
+    EXPECT_EQ(tree.max(), "Bar");
+    EXPECT_EQ(tree.removeMax(), "Bar");
+    EXPECT_EQ(tree.max(), "Foo");
+}
+
 TEST(BinaryTreeGenericTest, StringEqualityWithComparator) {
     BinaryTree<std::string, LengthComparator> tree;
 
@@ -275,4 +305,37 @@ TEST_F(BinaryTreeTest, DeepTreeHeightRecalculation) {
     tree.remove(10);
     tree.remove(30);
     EXPECT_EQ(tree.getRoot()->getHeight(), 3);
-}
\ No newline at end of file
+}
+
+TEST_F(BinaryTreeTest, BulkRemoveMinReportsRemovedCount) {
+    tree.insert(40, 3);
+    tree.insert(20, 2);
+    tree.insert(60);
+
+    auto taken = tree.removeMin(5);
+    EXPECT_EQ(taken.first, 20);
+    EXPECT_EQ(taken.second, 2u);
+    EXPECT_EQ(tree.min(), 40);
+
+    EXPECT_EQ(tree.remove(40, 2), 2u);
+    EXPECT_EQ(tree.removeMax(3).second, 1u);
+    EXPECT_EQ(tree.removeMin(), 40);
+    EXPECT_TRUE(tree.empty());
+}
+
+TEST_F(BinaryTreeTest, DrainHandlesDegenerateTree) {
+    // A sorted insert gives a 5000 deep spine, draining must not recurse
+    for (int x = 5000; x > 0; --x) tree.insert(x);
+    tree.insert(7);
+
+    std::vector<int> out;
+    tree.drain(std::back_inserter(out));
+    ASSERT_EQ(out.size(), 5001u);
+    EXPECT_TRUE(std::is_sorted(out.begin(), out.end()));
+    EXPECT_TRUE(tree.empty());
+
+    for (int x = 0; x < 5000; ++x) tree.insert(x);
+    tree.clear();
+    EXPECT_TRUE(tree.empty());
+    EXPECT_EQ(tree.nodesCount(), 0u);
+}
@@ -29,4 +29,33 @@ TEST_F(BinaryTreeNodeTest, UpdateHeightWithChildren) {
     root->getLeft()->setHeight(3); 
     root->updateHeight();
     EXPECT_EQ(root->getHeight(), 4);
-}
\ No newline at end of file
+}
+
+TEST_F(BinaryTreeNodeTest, CountsAreCheckedSixtyFourBit) {
+    BinaryTreeNode<int> node(7, 3000000000ull);
+    EXPECT_EQ(node.getCount(), 3000000000ull);
+
+    node.incrementCount(2000000000ull);
+    EXPECT_EQ(node.getCount(), 5000000000ull);
+    EXPECT_THROW(node.incrementCount(UINT64_MAX), std::overflow_error);
+    EXPECT_EQ(node.getCount(), 5000000000ull);
+
+    EXPECT_TRUE(node.decrementCount(4999999999ull));
+    EXPECT_FALSE(node.decrementCount(10));
+    EXPECT_EQ(node.getCount(), 0u);
+}
+
+TEST_F(BinaryTreeNodeTest, CacheAlignedLayoutFitsOneLine) {
+    using Node = BinaryTreeNode<int64_t, adsc::NoAugmentation<int64_t>, adsc::CacheAlignedNodeLayout>;
+    EXPECT_EQ(alignof(Node), 64u);
+    EXPECT_EQ(sizeof(Node), 64u);
+
+    auto node = std::make_unique<Node>(5);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(node.get()) % 64, 0u);
+
+    node->setLeft(std::make_unique<Node>(3));
+    node->getLeft()->setHeight(200);
+    node->updateHeight();
+    EXPECT_EQ(node->getHeight(), 201u);
+    EXPECT_EQ(node->getNodeBalance(), 200);
+}
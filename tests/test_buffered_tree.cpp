@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+#include "BufferedTree.hpp"
+
+#include <atomic>
+#include <limits>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using adsc::BufferedTree;
+using adsc::MergeMode;
+
+TEST(BufferedTreeTest, ZeroCapacityThrows) {
+    EXPECT_THROW(BufferedTree<int>(0), std::invalid_argument);
+}
+
+TEST(BufferedTreeTest, PendingOperationsApplyInOrder) {
+    BufferedTree<int> tree(1000);
+
+    // Removing an absent key is a no-op, so the insert that follows survives
+    tree.remove(5);
+    tree.insert(5);
+    EXPECT_EQ(tree.count(5), 1u);
+
+    tree.insert(7, 5);
+    tree.remove(7, 3);
+    EXPECT_EQ(tree.count(7), 2u);
+    tree.remove(7, 10);
+    tree.insert(7);
+    EXPECT_EQ(tree.count(7), 1u);
+    EXPECT_EQ(tree.bufferedCount(), 6u);
+
+    tree.flush();
+    EXPECT_EQ(tree.bufferedCount(), 0u);
+    EXPECT_EQ(tree.count(5), 1u);
+    EXPECT_EQ(tree.count(7), 1u);
+
+    // Pending removals reach into the merged copies
+    tree.insert(7, 2);
+    tree.remove(7, 2);
+    tree.remove(5);
+    EXPECT_EQ(tree.count(7), 1u);
+    EXPECT_FALSE(tree.search(5));
+    EXPECT_EQ(tree.elementsCount(), 1u);
+}
+
+TEST(BufferedTreeTest, RejectedOperationIsReportedAndTheRestKept) {
+    for (MergeMode mode : {MergeMode::Inline, MergeMode::Background}) {
+        BufferedTree<int> tree(1000, mode);
+        const uint64_t max = std::numeric_limits<uint64_t>::max();
+        tree.insert(7, max - 1);
+        tree.flush();
+
+        // 5 fills the element count up and merges, 7 overflows it, 8 is not reached
+        tree.insert(5);
+        tree.insert(7);
+        tree.insert(8, 2);
+        EXPECT_THROW(tree.flush(), std::overflow_error);
+        EXPECT_EQ(tree.count(5), 1u);
+        EXPECT_EQ(tree.count(7), max - 1);
+        EXPECT_EQ(tree.count(8), 2u);
+        EXPECT_GT(tree.bufferedCount(), 0u);
+
+        tree.remove(7);
+        tree.remove(8);
+        tree.flush();
+        EXPECT_EQ(tree.bufferedCount(), 0u);
+        EXPECT_EQ(tree.count(8), 1u);
+        EXPECT_EQ(tree.nodesCount(), 3u);
+    }
+}
+
+TEST(BufferedTreeTest, ReadYourWritesMatchesMultiset) {
+    for (MergeMode mode : {MergeMode::Inline, MergeMode::Background}) {
+        BufferedTree<int> tree(16, mode);
+        std::multiset<int> expected;
+        std::mt19937 g(9);
+
+        for (int i = 0; i < 20000; ++i) {
+            int key = static_cast<int>(g() % 200);
+            switch (g() % 4) {
+                case 0:
+                case 1:
+                    tree.insert(key);
+                    expected.insert(key);
+                    break;
+                case 2: {
+                    tree.remove(key);
+                    auto it = expected.find(key);
+                    if (it != expected.end()) expected.erase(it);
+                    break;
+                }
+                default:
+                    ASSERT_EQ(tree.count(key), expected.count(key)) << "key " << key;
+            }
+        }
+
+        std::vector<int> contents;
+        tree.forEach([&](int x) { contents.push_back(x); });
+        EXPECT_EQ(contents, std::vector<int>(expected.begin(), expected.end()));
+        EXPECT_EQ(tree.bufferedCount(), 0u);
+    }
+}
+
+TEST(BufferedTreeTest, ConcurrentWritersAndReaders) {
+    const int writers = 4;
+    const int perWriter = 5000;
+    BufferedTree<int> tree(64, MergeMode::Background);
+    std::atomic<bool> done{false};
+
+    std::vector<std::thread> threads;
+    for (int w = 0; w < writers; ++w) {
+        threads.emplace_back([&tree, w] {
+            for (int i = 0; i < perWriter; ++i) {
+                int key = i * writers + w;
+                tree.insert(key);
+                // Every write is visible to its writer right away
+                ASSERT_TRUE(tree.search(key));
+            }
+        });
+    }
+    std::thread reader([&] {
+        std::mt19937 g(1);
+        while (!done) tree.search(static_cast<int>(g() % (writers * perWriter)));
+    });
+    for (auto& thread : threads) thread.join();
+    done = true;
+    reader.join();
+
+    EXPECT_EQ(tree.elementsCount(), static_cast<size_t>(writers * perWriter));
+    for (int key = 0; key < writers * perWriter; ++key) {
+        ASSERT_EQ(tree.count(key), 1u);
+    }
+}
@@ -0,0 +1,205 @@
+#include <gtest/gtest.h>
+#include "ConcurrentAVLTree.hpp"
+
+#include <atomic>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using adsc::ConcurrentAVLTree;
+
+namespace {
+
+// Key counting its live instances, to observe when replaced nodes are freed
+struct Tracked {
+    static std::atomic<long> live;
+
+    explicit Tracked(int v) : value(v) { live++; }
+    Tracked(const Tracked& other) : value(other.value) { live++; }
+    Tracked& operator=(const Tracked&) = default;
+    ~Tracked() { live--; }
+
+    bool operator<(const Tracked& other) const { return value < other.value; }
+
+    int value;
+};
+
+std::atomic<long> Tracked::live{0};
+
+// Tracked key whose copies throw once copiesLeft runs out, negative never throws
+struct ThrowingCopy : Tracked {
+    static int copiesLeft;
+
+    explicit ThrowingCopy(int v) : Tracked(v) {}
+    ThrowingCopy(const ThrowingCopy& other) : Tracked(check(other)) {}
+    ThrowingCopy& operator=(const ThrowingCopy&) = default;
+
+    static const ThrowingCopy& check(const ThrowingCopy& other) {
+        if (copiesLeft == 0) throw std::runtime_error("copy failed");
+        if (copiesLeft > 0) --copiesLeft;
+        return other;
+    }
+};
+
+int ThrowingCopy::copiesLeft = -1;
+
+} // namespace
+
+TEST(ConcurrentAVLTreeTest, EmptyTreeThrows) {
+    ConcurrentAVLTree<int> tree;
+    EXPECT_TRUE(tree.empty());
+    EXPECT_FALSE(tree.search(1));
+    EXPECT_EQ(tree.remove(1, 5), 0u);
+    EXPECT_THROW(tree.removeMin(), std::runtime_error);
+    EXPECT_THROW(tree.removeMax(), std::runtime_error);
+    EXPECT_THROW(tree.min(), std::runtime_error);
+}
+
+TEST(ConcurrentAVLTreeTest, BulkCounts) {
+    ConcurrentAVLTree<int> tree;
+    tree.insert(4, 3);
+    tree.insert(2);
+    tree.insert(9, 2);
+    EXPECT_EQ(tree.nodesCount(), 3u);
+    EXPECT_EQ(tree.elementsCount(), 6u);
+    EXPECT_EQ(tree.count(4), 3u);
+
+    EXPECT_EQ(tree.remove(4, 2), 2u);
+    EXPECT_EQ(tree.count(4), 1u);
+    EXPECT_EQ(tree.remove(4, 10), 1u);
+    EXPECT_FALSE(tree.search(4));
+
+    EXPECT_EQ(tree.removeMax(5), std::make_pair(9, uint64_t(2)));
+    EXPECT_EQ(tree.min(), 2);
+    EXPECT_EQ(tree.max(), 2);
+    EXPECT_EQ(tree.elementsCount(), 1u);
+}
+
+TEST(ConcurrentAVLTreeTest, CountOverflowLeavesTreeIntact) {
+    ConcurrentAVLTree<int> tree;
+    tree.insert(7, std::numeric_limits<uint64_t>::max());
+    EXPECT_THROW(tree.insert(7), std::overflow_error);
+    EXPECT_THROW(tree.insert(8), std::overflow_error);
+    EXPECT_EQ(tree.count(7), std::numeric_limits<uint64_t>::max());
+    EXPECT_EQ(tree.nodesCount(), 1u);
+}
+
+TEST(ConcurrentAVLTreeTest, SortedInsertsStayBalanced) {
+    ConcurrentAVLTree<int> tree;
+    const int n = 100000;
+    for (int x = 0; x < n; ++x) tree.insert(x);
+    EXPECT_LE(tree.getHeight(), static_cast<uint32_t>(1.45 * std::log2(n + 2)));
+
+    for (int x = 0; x < n; x += 2) tree.remove(x);
+    EXPECT_LE(tree.getHeight(), static_cast<uint32_t>(1.45 * std::log2(n / 2 + 2)));
+
+    std::vector<int> contents;
+    tree.forEach([&](int x) { contents.push_back(x); });
+    ASSERT_EQ(contents.size(), static_cast<size_t>(n / 2));
+    for (size_t i = 0; i < contents.size(); ++i) ASSERT_EQ(contents[i], static_cast<int>(2 * i + 1));
+}
+
+TEST(ConcurrentAVLTreeTest, ReplacedNodesAreReclaimed) {
+    {
+        ConcurrentAVLTree<Tracked> tree;
+        std::mt19937 g(3);
+        for (int i = 0; i < 100000; ++i) {
+            int key = static_cast<int>(g() % 100);
+            if (g() % 2) tree.insert(Tracked(key));
+            else tree.remove(Tracked(key));
+        }
+        // Every write copies a path, without reclamation hundreds of thousands would be alive
+        EXPECT_LT(Tracked::live.load(), 5000);
+    }
+    EXPECT_EQ(Tracked::live.load(), 0);
+}
+
+TEST(ConcurrentAVLTreeTest, ReadersSeeConsistentVersions) {
+    // Even keys are never removed, odd keys churn under the writer
+    const int keyRange = 4096;
+    ConcurrentAVLTree<int> tree;
+    for (int x = 0; x < keyRange; x += 2) tree.insert(x);
+
+    std::atomic<bool> done{false};
+    std::atomic<long> failures{0};
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 3; ++r) {
+        readers.emplace_back([&, r] {
+            std::mt19937 g(r);
+            while (!done) {
+                int even = static_cast<int>(g() % keyRange) & ~1;
+                if (!tree.search(even)) failures++;
+                if (r == 0) {
+                    // A snapshot is sorted and holds every even key
+                    int previous = -1;
+                    int evens = 0;
+                    tree.forEach([&](int x) {
+                        if (x < previous) failures++;
+                        evens += x % 2 == 0;
+                        previous = x;
+                    });
+                    if (evens != keyRange / 2) failures++;
+                }
+            }
+        });
+    }
+
+    std::mt19937 g(99);
+    for (int i = 0; i < 50000; ++i) {
+        int odd = static_cast<int>(g() % keyRange) | 1;
+        if (g() % 2) tree.insert(odd);
+        else tree.remove(odd);
+    }
+    done = true;
+    for (auto& reader : readers) reader.join();
+
+    EXPECT_EQ(failures.load(), 0);
+    for (int x = 0; x < keyRange; x += 2) ASSERT_TRUE(tree.search(x));
+}
+
+TEST(ConcurrentAVLTreeTest, ThrowingWritesLeaveTreeIntact) {
+    {
+        ConcurrentAVLTree<ThrowingCopy> tree;
+        for (int x = 0; x < 512; x += 2) tree.insert(ThrowingCopy(x));
+
+        // Fail every write at each copy along its path in turn
+        std::vector<std::function<void()>> writes = {
+            [&] { tree.insert(ThrowingCopy(301)); },
+            [&] { tree.insert(ThrowingCopy(300)); },
+            [&] { tree.remove(ThrowingCopy(256)); },
+            [&] { tree.remove(ThrowingCopy(0)); },
+            [&] { tree.removeMin(); },
+            [&] { tree.removeMax(); },
+        };
+        for (auto& write : writes) {
+            // Retired nodes not freed yet are live too, count from here
+            const long live = Tracked::live.load();
+            for (int copies = 0; copies < 12; ++copies) {
+                ThrowingCopy::copiesLeft = copies;
+                try {
+                    write();
+                } catch (const std::runtime_error&) {
+                    ThrowingCopy::copiesLeft = -1;
+                    EXPECT_EQ(tree.nodesCount(), 256u);
+                    EXPECT_EQ(tree.elementsCount(), 256u);
+                    EXPECT_EQ(Tracked::live.load(), live);
+                    continue;
+                }
+                ThrowingCopy::copiesLeft = -1;
+                break;
+            }
+            // The write went through, rebuild the full tree for the next one
+            while (!tree.empty()) tree.removeMin();
+            for (int x = 0; x < 512; x += 2) tree.insert(ThrowingCopy(x));
+        }
+
+        // Later writes retire what they replace, nothing left over from the failed ones
+        for (int x = 0; x < 512; x += 2) tree.remove(ThrowingCopy(x));
+        EXPECT_TRUE(tree.empty());
+    }
+    EXPECT_EQ(Tracked::live.load(), 0);
+}
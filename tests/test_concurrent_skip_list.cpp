@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+#include "ConcurrentSkipList.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <random>
+#include <thread>
+#include <vector>
+
+using adsc::ConcurrentSkipList;
+
+class ConcurrentSkipListTest : public ::testing::Test {
+protected:
+    static constexpr int kThreads = 4;
+
+    template <typename Fn>
+    void runThreads(Fn fn) {
+        std::vector<std::thread> threads;
+        for (int t = 0; t < kThreads; ++t) threads.emplace_back(fn, t);
+        for (auto& thread : threads) thread.join();
+    }
+
+    ConcurrentSkipList<int> list;
+};
+
+TEST_F(ConcurrentSkipListTest, SingleThreadedSemantics) {
+    for (int x : {50, 50, 20, 80}) list.insert(x);
+    EXPECT_EQ(list.nodesCount(), 3);
+    EXPECT_EQ(list.elementsCount(), 4);
+    EXPECT_TRUE(list.search(50));
+
+    list.remove(50);
+    EXPECT_TRUE(list.search(50));
+    list.remove(50);
+    EXPECT_FALSE(list.search(50));
+
+    EXPECT_EQ(list.removeMax(), 80);
+    EXPECT_EQ(list.removeMin(), 20);
+    EXPECT_TRUE(list.empty());
+    EXPECT_THROW(list.removeMin(), std::runtime_error);
+    EXPECT_THROW(list.removeMax(), std::runtime_error);
+}
+
+TEST_F(ConcurrentSkipListTest, ConcurrentInsertsKeepEveryCopy) {
+    constexpr int kPerThread = 5000;
+    runThreads([&](int t) {
+        for (int i = 0; i < kPerThread; ++i) list.insert((i * 7 + t) % 1000);
+    });
+
+    EXPECT_EQ(list.elementsCount(), size_t(kThreads * kPerThread));
+    EXPECT_EQ(list.nodesCount(), 1000);
+
+    int previous = -1;
+    while (!list.empty()) {
+        int current = list.removeMin();
+        EXPECT_LE(previous, current);
+        previous = current;
+    }
+    EXPECT_EQ(list.nodesCount(), 0);
+}
+
+TEST_F(ConcurrentSkipListTest, ConcurrentMixedOperationsBalance) {
+    constexpr int kPerThread = 20000;
+    std::atomic<long> inserted{0};
+    std::atomic<long> removed{0};
+
+    runThreads([&](int t) {
+        std::mt19937 gen(t);
+        std::uniform_int_distribution<int> value(0, 255);
+        for (int i = 0; i < kPerThread; ++i) {
+            int x = value(gen);
+            switch (gen() % 4) {
+                case 0:
+                case 1:
+                    list.insert(x);
+                    inserted++;
+                    break;
+                case 2:
+                    list.search(x);
+                    list.remove(x);
+                    break;
+                default:
+                    try {
+                        (gen() % 2) ? list.removeMin() : list.removeMax();
+                        removed++;
+                    } catch (const std::runtime_error&) {
+                    }
+            }
+        }
+    });
+
+    // Drain what is left and check ordering plus the element balance
+    long remaining = 0;
+    int previous = -1;
+    while (!list.empty()) {
+        int current = list.removeMin();
+        EXPECT_LE(previous, current);
+        previous = current;
+        remaining++;
+    }
+    EXPECT_LE(remaining + removed.load(), inserted.load());
+    EXPECT_EQ(list.nodesCount(), 0);
+}
@@ -0,0 +1,266 @@
+#include <gtest/gtest.h>
+#include "AVLTree.hpp"
+#include "BinarySortingTree.hpp"
+#include "BinaryTree.hpp"
+#include "ConcurrentAVLTree.hpp"
+#include "HugePageArena.hpp"
+#include "RadixTree.hpp"
+#include "RcuTree.hpp"
+#include "ShardedTree.hpp"
+#include "SkipList.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <random>
+#include <set>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Differential conformance suite: every sorted container must behave exactly like
+// std::multiset under the same random operation stream. Containers exposing their
+// nodes get their structure checked as well.
+//
+// ADSC_STRESS_ITERATIONS raises the number of operations per run (stress mode),
+// ADSC_STRESS_SEED replays a failing run.
+
+namespace {
+
+size_t envOr(const char* name, size_t fallback) {
+    const char* value = std::getenv(name);
+    return value ? static_cast<size_t>(std::strtoull(value, nullptr, 10)) : fallback;
+}
+
+template <typename Tree, typename = void>
+struct HasRoot : std::false_type {};
+template <typename Tree>
+struct HasRoot<Tree, std::void_t<decltype(std::declval<const Tree&>().getRoot())>> : std::true_type {};
+
+template <typename Tree, typename = void>
+struct HasExtremes : std::false_type {};
+template <typename Tree>
+struct HasExtremes<Tree, std::void_t<decltype(std::declval<const Tree&>().min())>> : std::true_type {};
+
+template <typename Tree, typename = void>
+struct HasDrain : std::false_type {};
+template <typename Tree>
+struct HasDrain<Tree, std::void_t<decltype(std::declval<Tree&>().extractAll())>> : std::true_type {};
+
+template <typename Tree, typename = void>
+struct HasTombstones : std::false_type {};
+template <typename Tree>
+struct HasTombstones<Tree, std::void_t<decltype(std::declval<const Tree&>().tombstonesCount())>> : std::true_type {};
+
+// Configured variants of the trees under test
+struct LazyAVLTree : adsc::AVLTree<int> {
+    LazyAVLTree() { setLazyRemoval(true, 0.3); }
+};
+
+struct FingerAVLTree : adsc::AVLTree<int> {
+    FingerAVLTree() { setFingerSearch(true); }
+};
+
+// Sums of keys up to 2^30 need the 64-bit accumulator
+using SumAVLTree = adsc::AVLTree<int, std::less<int>, adsc::SumAugmentation<int, int64_t>>;
+using AlignedAVLTree = adsc::AVLTree<int, std::less<int>, adsc::NoAugmentation<int>, adsc::CacheAlignedNodeLayout>;
+using HugePageAVLTree = adsc::AVLTree<int, std::less<int>, adsc::NoAugmentation<int>, adsc::HugePageNodeLayout<>>;
+
+template <typename Tree>
+constexpr bool isBalanced() {
+    return !std::is_same<Tree, adsc::BinaryTree<int>>::value;
+}
+
+} // namespace
+
+template <typename Tree>
+class ConformanceTest : public ::testing::Test {
+protected:
+    // Returns the height of the subtree and counts its live nodes and elements
+    template <typename NodeType>
+    uint32_t checkNode(const NodeType* node, const int* lo, const int* hi, size_t& nodes, size_t& elements) {
+        if (!node) return 0;
+        const int& key = node->getData();
+        if (lo) {
+            EXPECT_LE(*lo, key);
+        }
+        if (hi) {
+            EXPECT_LE(key, *hi);
+        }
+
+        uint32_t left = checkNode(node->getLeft().get(), lo, &key, nodes, elements);
+        uint32_t right = checkNode(node->getRight().get(), &key, hi, nodes, elements);
+        EXPECT_EQ(node->getHeight(), 1 + std::max(left, right)) << "stale height at " << key;
+        if (isBalanced<Tree>()) {
+            EXPECT_LE(std::abs(static_cast<int>(left) - static_cast<int>(right)), 1) << "unbalanced at " << key;
+        }
+        nodes += node->getCount() > 0;
+        elements += node->getCount();
+        return 1 + std::max(left, right);
+    }
+
+    void checkAgainst(const std::multiset<int>& expected) {
+        ASSERT_EQ(tree.elementsCount(), expected.size());
+        ASSERT_EQ(tree.empty(), expected.empty());
+
+        size_t distinct = 0;
+        for (auto it = expected.begin(); it != expected.end(); it = expected.upper_bound(*it)) distinct++;
+        size_t tombstones = 0;
+        if constexpr (HasTombstones<Tree>::value) tombstones = tree.tombstonesCount();
+        ASSERT_EQ(tree.nodesCount() - tombstones, distinct);
+
+        if constexpr (HasExtremes<Tree>::value) {
+            if (!expected.empty()) {
+                ASSERT_EQ(tree.min(), *expected.begin());
+                ASSERT_EQ(tree.max(), *expected.rbegin());
+            }
+        }
+        if constexpr (HasRoot<Tree>::value) {
+            size_t nodes = 0;
+            size_t elements = 0;
+            checkNode(tree.getRoot().get(), nullptr, nullptr, nodes, elements);
+            ASSERT_EQ(nodes, distinct);
+            ASSERT_EQ(elements, expected.size());
+        }
+    }
+
+    // Random operation stream, heavy on duplicates, alternating growth and shrink phases
+    void runDifferential(uint64_t seed, size_t operations, int keyRange) {
+        std::mt19937_64 g(seed);
+        std::multiset<int> expected;
+        const size_t checkEvery = std::max<size_t>(1, operations / 200);
+
+        for (size_t i = 0; i < operations; ++i) {
+            bool growing = (i / 1000) % 2 == 0;
+            int key = static_cast<int>(g() % keyRange);
+            unsigned op = g() % 10;
+
+            if (op < (growing ? 5u : 2u)) {
+                tree.insert(key);
+                expected.insert(key);
+            } else if (op < 7) {
+                tree.remove(key);
+                auto it = expected.find(key);
+                if (it != expected.end()) expected.erase(it);
+            } else if (op == 7) {
+                ASSERT_EQ(tree.search(key), expected.count(key) > 0) << "search " << key << " seed " << seed;
+                if constexpr (HasRoot<Tree>::value) {
+                    ASSERT_EQ(tree.count(key), expected.count(key)) << "count " << key << " seed " << seed;
+                }
+            } else if (expected.empty()) {
+                EXPECT_THROW(op == 8 ? tree.removeMin() : tree.removeMax(), std::runtime_error);
+            } else if (op == 8) {
+                ASSERT_EQ(tree.removeMin(), *expected.begin()) << "seed " << seed;
+                expected.erase(expected.begin());
+            } else {
+                ASSERT_EQ(tree.removeMax(), *expected.rbegin()) << "seed " << seed;
+                expected.erase(std::prev(expected.end()));
+            }
+
+            if (i % checkEvery == 0) {
+                checkAgainst(expected);
+                if (::testing::Test::HasFatalFailure()) {
+                    FAIL() << "diverged after " << i << " operations, seed " << seed;
+                }
+            }
+        }
+        checkAgainst(expected);
+
+        if constexpr (HasDrain<Tree>::value) {
+            // Bulk extraction must agree with the in-order contents, then start over
+            std::vector<int> drained = tree.extractAll();
+            ASSERT_EQ(drained, std::vector<int>(expected.begin(), expected.end()));
+            ASSERT_TRUE(tree.empty());
+            for (int key : expected) tree.insert(key);
+            checkAgainst(expected);
+        }
+
+        // Drain in order
+        while (!expected.empty()) {
+            ASSERT_EQ(tree.removeMin(), *expected.begin());
+            expected.erase(expected.begin());
+        }
+        EXPECT_TRUE(tree.empty());
+    }
+
+    Tree tree;
+};
+
+using Implementations = ::testing::Types<
+    adsc::BinaryTree<int>,
+    adsc::AVLTree<int>,
+    LazyAVLTree,
+    FingerAVLTree,
+    SumAVLTree,
+    AlignedAVLTree,
+    HugePageAVLTree,
+    adsc::SkipList<int>,
+    adsc::ShardedTree<int>,
+    adsc::RadixTree<int>,
+    adsc::ConcurrentAVLTree<int>,
+    adsc::RcuTree<int>>;
+TYPED_TEST_SUITE(ConformanceTest, Implementations);
+
+TYPED_TEST(ConformanceTest, MatchesMultisetOnRandomOperations) {
+    uint64_t seed = envOr("ADSC_STRESS_SEED", 42);
+    size_t operations = envOr("ADSC_STRESS_ITERATIONS", 20000);
+    this->runDifferential(seed, operations, 500);
+}
+
+TYPED_TEST(ConformanceTest, MatchesMultisetOnWideKeyRange) {
+    // The printed seed replays the failure through ADSC_STRESS_SEED
+    uint64_t seed = envOr("ADSC_STRESS_SEED", 8);
+    size_t operations = envOr("ADSC_STRESS_ITERATIONS", 20000);
+    this->runDifferential(seed, operations, 1 << 30);
+}
+
+TYPED_TEST(ConformanceTest, SortedRunsAndReverseDrain) {
+    std::multiset<int> expected;
+    for (int x = 0; x < 2000; ++x) {
+        this->tree.insert(x / 3);
+        expected.insert(x / 3);
+    }
+    for (int x = 3000; x > 2000; --x) {
+        this->tree.insert(x);
+        expected.insert(x);
+    }
+    this->checkAgainst(expected);
+
+    while (!expected.empty()) {
+        ASSERT_EQ(this->tree.removeMax(), *expected.rbegin());
+        expected.erase(std::prev(expected.end()));
+    }
+    EXPECT_TRUE(this->tree.empty());
+    EXPECT_THROW(this->tree.removeMax(), std::runtime_error);
+}
+
+// The type-erased adapter must forward everything unchanged
+TEST(ConformanceAdapterTest, AdapterMatchesMultiset) {
+    adsc::TreeAdapter<adsc::AVLTree<int>> adapter;
+    adsc::BinarySortingTree<int>& tree = adapter;
+    std::multiset<int> expected;
+    std::mt19937 g(envOr("ADSC_STRESS_SEED", 3));
+
+    for (size_t i = 0; i < envOr("ADSC_STRESS_ITERATIONS", 20000); ++i) {
+        int key = static_cast<int>(g() % 300);
+        switch (g() % 4) {
+            case 0:
+            case 1:
+                tree.insert(key);
+                expected.insert(key);
+                break;
+            case 2: {
+                tree.remove(key);
+                auto it = expected.find(key);
+                if (it != expected.end()) expected.erase(it);
+                break;
+            }
+            default:
+                if (!expected.empty()) {
+                    ASSERT_EQ(tree.removeMin(), *expected.begin());
+                    expected.erase(expected.begin());
+                }
+        }
+        ASSERT_EQ(tree.elementsCount(), expected.size());
+        ASSERT_EQ(tree.search(key), expected.count(key) > 0);
+    }
+}
@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+#include "EpochReclaimer.hpp"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using adsc::EpochReclaimer;
+
+namespace {
+
+struct Tracked {
+    explicit Tracked(int& counter) : m_counter(counter) {}
+    ~Tracked() { m_counter++; }
+    int& m_counter;
+};
+
+} // namespace
+
+TEST(EpochReclaimerTest, PinnedReaderDelaysReclamation) {
+    int destroyed = 0;
+    EpochReclaimer reclaimer;
+
+    std::thread reader;
+    {
+        // Keep a guard from an older epoch alive on another thread
+        std::atomic<bool> pinned{false};
+        std::atomic<bool> done{false};
+        reader = std::thread([&] {
+            auto guard = reclaimer.pin();
+            pinned = true;
+            while (!done) std::this_thread::yield();
+        });
+        while (!pinned) std::this_thread::yield();
+
+        for (int i = 0; i < 1000; ++i) {
+            auto guard = reclaimer.pin();
+            guard.retire(new Tracked(destroyed));
+        }
+        EXPECT_EQ(destroyed, 0);
+        EXPECT_LE(reclaimer.getEpoch(), 1);
+
+        done = true;
+        reader.join();
+    }
+
+    for (int i = 0; i < 1000; ++i) {
+        auto guard = reclaimer.pin();
+        guard.retire(new Tracked(destroyed));
+    }
+    EXPECT_GT(destroyed, 0);
+}
+
+TEST(EpochReclaimerTest, DestructorFreesEverything) {
+    int destroyed = 0;
+    {
+        EpochReclaimer reclaimer;
+        auto guard = reclaimer.pin();
+        for (int i = 0; i < 10; ++i) guard.retire(new Tracked(destroyed));
+    }
+    EXPECT_EQ(destroyed, 10);
+}
+
+TEST(EpochReclaimerTest, ReclaimFreesWithoutWaitingForABatch) {
+    int destroyed = 0;
+    EpochReclaimer reclaimer;
+    {
+        auto guard = reclaimer.pin();
+        guard.retire(new Tracked(destroyed));
+        guard.reclaim();
+    }
+    // Two epochs must pass, the retiring guard itself holds back the second one
+    EXPECT_EQ(destroyed, 0);
+    {
+        auto guard = reclaimer.pin();
+        guard.reclaim();
+    }
+    EXPECT_EQ(destroyed, 1);
+}
+
+TEST(EpochReclaimerTest, OthersCollectWhatAnExitedThreadRetired) {
+    int destroyed = 0;
+    EpochReclaimer reclaimer;
+    std::thread([&] {
+        auto guard = reclaimer.pin();
+        for (int i = 0; i < 10; ++i) guard.retire(new Tracked(destroyed));
+    }).join();
+
+    for (int i = 0; i < 2; ++i) {
+        auto guard = reclaimer.pin();
+        guard.reclaim();
+    }
+    EXPECT_EQ(destroyed, 10);
+}
+
+TEST(EpochReclaimerTest, MoreThreadsThanSlotsPinAtOnce) {
+    const int threads = 3 * static_cast<int>(EpochReclaimer::kSlotsPerBlock) + 5;
+    std::atomic<int> destroyed{0};
+    struct Counted {
+        explicit Counted(std::atomic<int>& counter) : m_counter(counter) {}
+        ~Counted() { m_counter++; }
+        std::atomic<int>& m_counter;
+    };
+
+    EpochReclaimer reclaimer;
+    std::atomic<int> pinned{0};
+    std::vector<std::thread> pinners;
+    for (int t = 0; t < threads; ++t) {
+        pinners.emplace_back([&] {
+            auto guard = reclaimer.pin();
+            guard.retire(new Counted(destroyed));
+            // Every guard stays alive until all threads hold one
+            pinned++;
+            while (pinned < threads) std::this_thread::yield();
+        });
+    }
+    for (auto& pinner : pinners) pinner.join();
+    EXPECT_EQ(pinned.load(), threads);
+
+    for (int i = 0; i < 2; ++i) {
+        auto guard = reclaimer.pin();
+        guard.reclaim();
+    }
+    EXPECT_EQ(destroyed.load(), threads);
+}
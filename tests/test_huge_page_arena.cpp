@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+#include "HugePageArena.hpp"
+#include "AVLTree.hpp"
+
+#include <cstdint>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+using adsc::ArenaStats;
+using adsc::HugePageArena;
+using adsc::HugePageNodeLayout;
+using adsc::NumaPolicy;
+
+namespace {
+
+template <typename Layout, typename T = int>
+using ArenaTree = adsc::AVLTree<T, std::less<T>, adsc::NoAugmentation<T>, Layout>;
+
+// Distinct policies get distinct arenas, so each test starts from a fresh one
+using BindArena = HugePageArena<NumaPolicy::Bind, 0>;
+
+} // namespace
+
+TEST(HugePageArenaTest, FreedBlocksAreReused) {
+    using Arena = HugePageArena<NumaPolicy::Local, 1>;
+    void* a = Arena::allocate(40, 16);
+    void* b = Arena::allocate(40, 16);
+    EXPECT_NE(a, b);
+    EXPECT_EQ(Arena::stats().allocatedBytes, 96u);
+
+    Arena::deallocate(a, 40, 16);
+    EXPECT_EQ(Arena::allocate(48, 16), a);
+    Arena::deallocate(a, 48, 16);
+    Arena::deallocate(b, 40, 16);
+    EXPECT_EQ(Arena::stats().allocatedBytes, 0u);
+    EXPECT_EQ(Arena::stats().mappedBytes, Arena::kChunkSize);
+}
+
+TEST(HugePageArenaTest, BlocksAreAligned) {
+    using Arena = HugePageArena<NumaPolicy::Local, 2>;
+    std::vector<void*> blocks;
+    for (size_t size : {8, 24, 64, 80, 200}) {
+        for (size_t alignment : {16, 32, 64}) {
+            void* block = Arena::allocate(size, alignment);
+            EXPECT_EQ(reinterpret_cast<uintptr_t>(block) % alignment, 0u) << size << " " << alignment;
+            Arena::deallocate(block, size, alignment);
+        }
+    }
+
+    // Too large or too aligned for the size classes, served by operator new
+    void* large = Arena::allocate(4096, 16);
+    void* page = Arena::allocate(64, 4096);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(page) % 4096, 0u);
+    Arena::deallocate(large, 4096, 16);
+    Arena::deallocate(page, 64, 4096);
+    EXPECT_EQ(Arena::stats().allocatedBytes, 0u);
+}
+
+TEST(HugePageArenaTest, TreeNodesComeFromTheArena) {
+    using Layout = HugePageNodeLayout<NumaPolicy::Local, 3>;
+    std::multiset<int> expected;
+    {
+        ArenaTree<Layout> tree;
+        std::mt19937 g(5);
+        for (int i = 0; i < 200000; ++i) {
+            int key = static_cast<int>(g() % 50000);
+            tree.insert(key);
+            expected.insert(key);
+        }
+        EXPECT_GT(Layout::allocator::stats().allocatedBytes, tree.nodesCount() * sizeof(int));
+
+        for (int key = 0; key < 50000; key += 3) {
+            tree.remove(key);
+            auto it = expected.find(key);
+            if (it != expected.end()) expected.erase(it);
+        }
+        std::vector<int> contents;
+        tree.forEach([&](int x) { contents.push_back(x); });
+        EXPECT_EQ(contents, std::vector<int>(expected.begin(), expected.end()));
+    }
+    ArenaStats stats = Layout::allocator::stats();
+    EXPECT_EQ(stats.allocatedBytes, 0u);
+    EXPECT_EQ(stats.mappedBytes % HugePageArena<>::kHugePageSize, 0u);
+}
+
+TEST(HugePageArenaTest, NumaPoliciesKeepTreesWorking) {
+    // mbind may be refused (no NUMA, seccomp), the chunks are still usable
+    ArenaTree<HugePageNodeLayout<NumaPolicy::Interleave>, std::string> strings;
+    ArenaTree<HugePageNodeLayout<NumaPolicy::Bind, 0>> ints;
+    for (int i = 0; i < 10000; ++i) {
+        strings.insert(std::to_string(i));
+        ints.insert(i);
+    }
+    EXPECT_TRUE(strings.search("9999"));
+    EXPECT_EQ(ints.removeMax(), 9999);
+    EXPECT_EQ(BindArena::stats().mappedBytes, BindArena::kChunkSize);
+}
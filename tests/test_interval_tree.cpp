@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+#include "IntervalTree.hpp"
+
+#include <random>
+#include <vector>
+
+using adsc::Interval;
+using adsc::IntervalTree;
+
+class IntervalTreeTest : public ::testing::Test {
+protected:
+    std::vector<Interval<int>> collect(int start, int end) const {
+        std::vector<Interval<int>> result;
+        tree.overlapping(start, end, [&](const Interval<int>& interval) { result.push_back(interval); });
+        return result;
+    }
+
+    IntervalTree<int> tree;
+};
+
+TEST_F(IntervalTreeTest, ReportsOverlapsInStartOrder) {
+    tree.insert(15, 20);
+    tree.insert(10, 30);
+    tree.insert(17, 19);
+    tree.insert(5, 20);
+    tree.insert(12, 15);
+    tree.insert(30, 40);
+
+    std::vector<Interval<int>> expected = {{5, 20}, {10, 30}, {12, 15}};
+    EXPECT_EQ(collect(14, 16).size(), 4u);
+    EXPECT_EQ(collect(6, 14), expected);
+    EXPECT_TRUE(collect(41, 50).empty());
+    EXPECT_EQ(collect(40, 40), (std::vector<Interval<int>>{{30, 40}}));
+
+    EXPECT_TRUE(tree.overlapsAny(19, 19));
+    EXPECT_FALSE(tree.overlapsAny(0, 4));
+    EXPECT_FALSE(tree.overlapsAny(41, 100));
+}
+
+TEST_F(IntervalTreeTest, DuplicatesAndRemoval) {
+    tree.insert(1, 5);
+    tree.insert(1, 5);
+    tree.insert(3, 9);
+
+    EXPECT_EQ(tree.nodesCount(), 2);
+    EXPECT_EQ(collect(4, 4).size(), 3u);
+
+    tree.remove(1, 5);
+    EXPECT_EQ(collect(4, 4).size(), 2u);
+
+    tree.remove(3, 9);
+    EXPECT_EQ(collect(6, 8).size(), 0u);
+    EXPECT_FALSE(tree.overlapsAny(6, 8));
+    EXPECT_EQ(tree.getRoot()->getAggregate(), 5);
+}
+
+TEST_F(IntervalTreeTest, MatchesLinearScan) {
+    std::mt19937 gen(5);
+    std::vector<Interval<int>> stored;
+    for (int i = 0; i < 2000; ++i) {
+        int start = static_cast<int>(gen() % 10000);
+        Interval<int> interval{start, start + static_cast<int>(gen() % 300)};
+        tree.insert(interval);
+        stored.push_back(interval);
+    }
+    for (int i = 0; i < 500; ++i) {
+        tree.remove(stored[i]);
+    }
+    stored.erase(stored.begin(), stored.begin() + 500);
+
+    for (int q = 0; q < 200; ++q) {
+        int start = static_cast<int>(gen() % 10500);
+        int end = start + static_cast<int>(gen() % 100);
+
+        size_t expected = 0;
+        for (const auto& interval : stored) {
+            if (interval.start <= end && start <= interval.end) expected++;
+        }
+        EXPECT_EQ(collect(start, end).size(), expected);
+        EXPECT_EQ(tree.overlapsAny(start, end), expected > 0);
+    }
+}
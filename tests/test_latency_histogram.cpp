@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+#include "LatencyHistogram.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <sstream>
+#include <vector>
+#include <algorithm>
+
+using adsc::LatencyHistogram;
+
+TEST(LatencyHistogramTest, EmptyHistogram) {
+    LatencyHistogram histogram;
+    EXPECT_EQ(histogram.count(), 0u);
+    EXPECT_EQ(histogram.min(), 0u);
+    EXPECT_EQ(histogram.max(), 0u);
+    EXPECT_EQ(histogram.valueAtPercentile(99.0), 0u);
+}
+
+TEST(LatencyHistogramTest, SmallValuesAreExact) {
+    LatencyHistogram histogram;
+    for (uint64_t v = 1; v <= 100; ++v) histogram.record(v);
+
+    EXPECT_EQ(histogram.count(), 100u);
+    EXPECT_EQ(histogram.min(), 1u);
+    EXPECT_EQ(histogram.max(), 100u);
+    EXPECT_EQ(histogram.valueAtPercentile(50.0), 50u);
+    EXPECT_EQ(histogram.valueAtPercentile(99.0), 99u);
+    EXPECT_EQ(histogram.valueAtPercentile(100.0), 100u);
+    EXPECT_DOUBLE_EQ(histogram.mean(), 50.5);
+}
+
+TEST(LatencyHistogramTest, PercentilesWithinRelativeError) {
+    std::mt19937_64 g(3);
+    std::lognormal_distribution<double> latency(6.0, 1.5);
+    std::vector<uint64_t> samples;
+    LatencyHistogram histogram;
+    for (int i = 0; i < 100000; ++i) {
+        uint64_t v = static_cast<uint64_t>(latency(g));
+        samples.push_back(v);
+        histogram.record(v);
+    }
+    std::sort(samples.begin(), samples.end());
+
+    for (double p : {50.0, 90.0, 99.0, 99.9, 99.99}) {
+        uint64_t exact = samples[static_cast<size_t>(std::ceil(p / 100.0 * samples.size())) - 1];
+        uint64_t reported = histogram.valueAtPercentile(p);
+        // Reported values are bucket upper bounds, never below the exact one
+        EXPECT_GE(reported, exact) << "p" << p;
+        EXPECT_LE(reported, exact + exact / 128 + 1) << "p" << p;
+    }
+    EXPECT_EQ(histogram.valueAtPercentile(100.0), samples.back());
+}
+
+TEST(LatencyHistogramTest, CoversFullRange) {
+    LatencyHistogram histogram;
+    histogram.record(UINT64_MAX);
+    histogram.record(uint64_t(1) << 40);
+
+    EXPECT_EQ(histogram.max(), UINT64_MAX);
+    EXPECT_EQ(histogram.valueAtPercentile(100.0), UINT64_MAX);
+    uint64_t low = histogram.valueAtPercentile(50.0);
+    EXPECT_GE(low, uint64_t(1) << 40);
+    EXPECT_LE(low, (uint64_t(1) << 40) + (uint64_t(1) << 33));
+}
+
+TEST(LatencyHistogramTest, MergeAndReset) {
+    LatencyHistogram a;
+    LatencyHistogram b;
+    for (uint64_t v = 0; v < 50; ++v) a.record(v);
+    for (uint64_t v = 50; v < 100; ++v) b.record(v);
+
+    a.merge(b);
+    EXPECT_EQ(a.count(), 100u);
+    EXPECT_EQ(a.min(), 0u);
+    EXPECT_EQ(a.max(), 99u);
+    EXPECT_EQ(a.valueAtPercentile(75.0), 74u);
+
+    a.reset();
+    EXPECT_EQ(a.count(), 0u);
+    EXPECT_EQ(a.valueAtPercentile(50.0), 0u);
+}
+
+TEST(LatencyHistogramTest, JsonOutput) {
+    LatencyHistogram histogram;
+    histogram.record(10);
+    histogram.record(20);
+
+    std::ostringstream out;
+    histogram.printJson(out);
+    EXPECT_EQ(out.str(), "{\"count\": 2, \"mean\": 15, \"p50\": 10, \"p99\": 20, \"p99.9\": 20, \"max\": 20}");
+}
@@ -0,0 +1,150 @@
+#include <gtest/gtest.h>
+#include "LearnedIndex.hpp"
+#include "AVLTree.hpp"
+#include "BinaryTree.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <random>
+#include <vector>
+
+using adsc::AVLTree;
+using adsc::LearnedIndex;
+
+namespace {
+
+// Checks search, count and lowerBound against the tree's multiset contents
+template <typename T, size_t Epsilon>
+void expectMatches(const LearnedIndex<T, Epsilon>& index, const std::map<T, uint64_t>& expected,
+                   const std::vector<T>& probes) {
+    for (const T& key : probes) {
+        auto it = expected.lower_bound(key);
+        const T* found = index.lowerBound(key);
+        if (it == expected.end()) {
+            ASSERT_EQ(found, nullptr) << key;
+        } else {
+            ASSERT_NE(found, nullptr) << key;
+            ASSERT_EQ(*found, it->first) << key;
+        }
+        uint64_t count = it != expected.end() && it->first == key ? it->second : 0;
+        ASSERT_EQ(index.count(key), count) << key;
+        ASSERT_EQ(index.search(key), count > 0) << key;
+    }
+}
+
+} // namespace
+
+TEST(LearnedIndexTest, EmptyTree) {
+    AVLTree<int> tree;
+    LearnedIndex<int> index(tree);
+    EXPECT_EQ(index.nodesCount(), 0u);
+    EXPECT_FALSE(index.search(1));
+    EXPECT_EQ(index.count(1), 0u);
+    EXPECT_EQ(index.lowerBound(1), nullptr);
+}
+
+TEST(LearnedIndexTest, CountsMultiplicities) {
+    AVLTree<int> tree;
+    tree.insert(5, 3);
+    tree.insert(9);
+    tree.insert(-2, 7);
+
+    LearnedIndex<int> index(tree);
+    EXPECT_EQ(index.nodesCount(), 3u);
+    EXPECT_EQ(index.elementsCount(), 11u);
+    EXPECT_EQ(index.count(5), 3u);
+    EXPECT_EQ(index.count(-2), 7u);
+    EXPECT_EQ(index.count(6), 0u);
+    EXPECT_EQ(*index.lowerBound(6), 9);
+}
+
+TEST(LearnedIndexTest, SkipsTombstones) {
+    AVLTree<int> tree;
+    tree.setLazyRemoval(true, 0.9);
+    for (int x = 0; x < 100; ++x) tree.insert(x);
+    tree.remove(50);
+
+    LearnedIndex<int> index(tree);
+    EXPECT_EQ(index.nodesCount(), 99u);
+    EXPECT_FALSE(index.search(50));
+    EXPECT_EQ(*index.lowerBound(50), 51);
+}
+
+TEST(LearnedIndexTest, UniformKeysNeedOneSegment) {
+    AVLTree<int64_t> tree;
+    std::map<int64_t, uint64_t> expected;
+    for (int64_t x = 0; x < 100000; x += 10) {
+        tree.insert(x);
+        expected[x]++;
+    }
+
+    LearnedIndex<int64_t> index(tree);
+    EXPECT_EQ(index.segmentsCount(), 1u);
+    EXPECT_EQ(index.levelsCount(), 1u);
+
+    std::vector<int64_t> probes;
+    for (int64_t x = -15; x < 100015; x += 3) probes.push_back(x);
+    expectMatches(index, expected, probes);
+}
+
+TEST(LearnedIndexTest, SkewedKeysMatchTree) {
+    std::mt19937_64 g(17);
+    std::lognormal_distribution<double> skewed(10.0, 2.0);
+    adsc::BinaryTree<uint64_t> tree;
+    std::map<uint64_t, uint64_t> expected;
+    std::vector<uint64_t> probes;
+    for (int i = 0; i < 50000; ++i) {
+        uint64_t x = static_cast<uint64_t>(skewed(g));
+        tree.insert(x);
+        expected[x]++;
+        probes.push_back(x);
+        probes.push_back(x + 1);
+        probes.push_back(x > 0 ? x - 1 : 0);
+    }
+    probes.push_back(std::numeric_limits<uint64_t>::max());
+
+    LearnedIndex<uint64_t, 8> index(tree);
+    EXPECT_EQ(index.elementsCount(), 50000u);
+    EXPECT_GT(index.segmentsCount(), 1u);
+    EXPECT_GT(index.levelsCount(), 1u);
+    expectMatches(index, expected, probes);
+}
+
+TEST(LearnedIndexTest, ExtremeKeys) {
+    // Neighbouring keys beyond 2^53 collapse to the same double
+    AVLTree<uint64_t> tree;
+    std::map<uint64_t, uint64_t> expected;
+    std::vector<uint64_t> probes;
+    const uint64_t top = std::numeric_limits<uint64_t>::max();
+    for (uint64_t i = 0; i < 2000; ++i) {
+        for (uint64_t x : {i * 3, top - i * 5, (uint64_t(1) << 60) + i}) {
+            tree.insert(x);
+            expected[x]++;
+            probes.push_back(x);
+            probes.push_back(x + 1);
+        }
+    }
+
+    LearnedIndex<uint64_t, 4> index(tree);
+    expectMatches(index, expected, probes);
+}
+
+TEST(LearnedIndexTest, FloatingPointKeys) {
+    AVLTree<double> tree;
+    std::map<double, uint64_t> expected;
+    std::vector<double> probes;
+    std::mt19937 g(2);
+    std::exponential_distribution<double> skewed(0.5);
+    for (int i = 0; i < 20000; ++i) {
+        double x = skewed(g);
+        tree.insert(x);
+        expected[x]++;
+        probes.push_back(x);
+        probes.push_back(std::nextafter(x, 100.0));
+    }
+
+    LearnedIndex<double> index(tree);
+    expectMatches(index, expected, probes);
+}
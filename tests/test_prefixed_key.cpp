@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+#include "PrefixedKey.hpp"
+#include "AVLTree.hpp"
+
+#include <algorithm>
+#include <array>
+#include <random>
+#include <string>
+#include <vector>
+
+using adsc::PrefixedKey;
+
+using Key = std::array<char, 64>;
+
+static Key makeKey(const std::string& text) {
+    Key key{};
+    std::copy(text.begin(), text.end(), key.begin());
+    return key;
+}
+
+TEST(PrefixedKeyTest, PrefixPreservesOrder) {
+    std::vector<std::string> words{"", "a", "ab", "abcdefgh", "abcdefghi", "abcdefgz", "b", "\x7f", "\x80", "\xff"};
+    for (const auto& a : words) {
+        for (const auto& b : words) {
+            PrefixedKey<std::string> pa(a), pb(b);
+            EXPECT_EQ(pa < pb, a < b) << a << " / " << b;
+            EXPECT_EQ(pa == pb, a == b);
+            if (pa.prefix() < pb.prefix()) {
+                EXPECT_LT(a, b);
+            }
+
+            PrefixedKey<Key> ka(makeKey(a)), kb(makeKey(b));
+            EXPECT_EQ(ka < kb, makeKey(a) < makeKey(b)) << a << " / " << b;
+        }
+    }
+}
+
+TEST(PrefixedKeyTest, CopiesOwnTheirKey) {
+    PrefixedKey<std::string> original(std::string(300, 'x'));
+    PrefixedKey<std::string> copy(original);
+    EXPECT_EQ(copy, original);
+    EXPECT_NE(&copy.get(), &original.get());
+
+    PrefixedKey<std::string> other(std::string("y"));
+    other = copy;
+    EXPECT_EQ(other.get(), std::string(300, 'x'));
+}
+
+TEST(PrefixedKeyTest, AVLTreeOrdersLargeKeysByPrefixThenKey) {
+    adsc::AVLTree<PrefixedKey<Key>, std::less<PrefixedKey<Key>>,
+                  adsc::NoAugmentation<PrefixedKey<Key>>, adsc::CacheAlignedNodeLayout> tree;
+
+    // Shared 8-byte prefix forces the out of line comparison
+    std::vector<std::string> words;
+    std::mt19937 g(5);
+    for (int i = 0; i < 500; ++i) words.push_back("prefix__" + std::to_string(g() % 300));
+    for (const auto& word : words) tree.insert(PrefixedKey<Key>(makeKey(word)));
+
+    std::sort(words.begin(), words.end());
+    EXPECT_EQ(tree.elementsCount(), words.size());
+    EXPECT_TRUE(tree.search(PrefixedKey<Key>(makeKey(words[17]))));
+    EXPECT_FALSE(tree.search(PrefixedKey<Key>(makeKey("prefix__x"))));
+    for (const auto& word : words) {
+        EXPECT_EQ(tree.removeMin().get(), makeKey(word));
+    }
+}
@@ -0,0 +1,151 @@
+#include <gtest/gtest.h>
+#include "RadixTree.hpp"
+#include "BinarySortingTree.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using adsc::RadixTree;
+
+namespace {
+
+template <typename T>
+std::vector<T> contents(const RadixTree<T>& tree) {
+    std::vector<T> out;
+    tree.forEach([&](const T& x) { out.push_back(x); });
+    return out;
+}
+
+} // namespace
+
+TEST(RadixTreeTest, EmptyTree) {
+    RadixTree<int> tree;
+    EXPECT_TRUE(tree.empty());
+    EXPECT_FALSE(tree.search(0));
+    EXPECT_THROW(tree.removeMin(), std::runtime_error);
+    EXPECT_THROW(tree.max(), std::runtime_error);
+    tree.remove(3);
+    EXPECT_EQ(tree.elementsCount(), 0u);
+}
+
+TEST(RadixTreeTest, SignedIntegersInOrder) {
+    RadixTree<int64_t> tree;
+    std::vector<int64_t> keys = {0, -1, 1, std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max(),
+                                 256, 255, -256, 65536};
+    for (int64_t x : keys) tree.insert(x);
+
+    std::multiset<int64_t> expected(keys.begin(), keys.end());
+    EXPECT_EQ(contents(tree), std::vector<int64_t>(expected.begin(), expected.end()));
+    EXPECT_EQ(tree.min(), std::numeric_limits<int64_t>::min());
+    EXPECT_EQ(tree.removeMax(), std::numeric_limits<int64_t>::max());
+}
+
+TEST(RadixTreeTest, StringsThatArePrefixesOfOthers) {
+    RadixTree<std::string> tree;
+    std::vector<std::string> keys = {"http://a.com/x", "http://a.com", "http://a.com/", "", "http://b.org",
+                                     "http", std::string("a\0b", 3), "a", std::string("a\0", 2), "\xff"};
+    std::multiset<std::string> expected;
+    for (const auto& key : keys) {
+        tree.insert(key);
+        expected.insert(key);
+    }
+    EXPECT_EQ(contents(tree), std::vector<std::string>(expected.begin(), expected.end()));
+    for (const auto& key : keys) EXPECT_TRUE(tree.search(key)) << key;
+    EXPECT_FALSE(tree.search("http://a"));
+    EXPECT_FALSE(tree.search("http://a.com/xy"));
+
+    // Removing the keys a path was split for compresses it again
+    tree.remove("http://a.com");
+    tree.remove("http");
+    expected.erase("http://a.com");
+    expected.erase("http");
+    EXPECT_EQ(contents(tree), std::vector<std::string>(expected.begin(), expected.end()));
+    EXPECT_EQ(tree.removeMin(), "");
+    EXPECT_EQ(tree.removeMax(), "\xff");
+}
+
+TEST(RadixTreeTest, NodesGrowAndShrink) {
+    // Every first byte under one parent forces Node4 -> 16 -> 48 -> 256 and back
+    RadixTree<uint16_t> tree;
+    for (uint32_t b = 0; b < 256; ++b) tree.insert(static_cast<uint16_t>(b << 8 | 7));
+    for (uint32_t b = 0; b < 256; ++b) tree.insert(static_cast<uint16_t>(b << 8 | 9));
+    EXPECT_EQ(tree.nodesCount(), 512u);
+
+    for (uint32_t b = 0; b < 256; ++b) {
+        tree.remove(static_cast<uint16_t>(b << 8 | 7));
+        ASSERT_TRUE(tree.search(static_cast<uint16_t>(b << 8 | 9)));
+    }
+    for (uint32_t b = 0; b < 255; ++b) tree.remove(static_cast<uint16_t>(b << 8 | 9));
+    EXPECT_EQ(tree.nodesCount(), 1u);
+    EXPECT_EQ(tree.min(), static_cast<uint16_t>(255 << 8 | 9));
+}
+
+TEST(RadixTreeTest, BulkCounts) {
+    RadixTree<uint32_t> tree;
+    tree.insert(10, 5);
+    tree.insert(10);
+    EXPECT_EQ(tree.count(10), 6u);
+    EXPECT_EQ(tree.remove(10, 4), 4u);
+    EXPECT_EQ(tree.remove(10, 9), 2u);
+    EXPECT_FALSE(tree.search(10));
+
+    tree.insert(3, std::numeric_limits<uint64_t>::max() - 1);
+    EXPECT_THROW(tree.insert(3, 2), std::overflow_error);
+    auto taken = tree.removeMin(std::numeric_limits<uint64_t>::max());
+    EXPECT_EQ(taken.first, 3u);
+    EXPECT_EQ(taken.second, std::numeric_limits<uint64_t>::max() - 1);
+    EXPECT_TRUE(tree.empty());
+}
+
+TEST(RadixTreeTest, RandomUrlsMatchMultiset) {
+    std::mt19937 g(21);
+    std::vector<std::string> hosts = {"example.com", "example.org", "ex.io", "a.b.c.example.com"};
+    auto url = [&] {
+        std::string s = "https://" + hosts[g() % hosts.size()];
+        for (int depth = g() % 4; depth > 0; --depth) s += "/p" + std::to_string(g() % 20);
+        return s;
+    };
+
+    RadixTree<std::string> tree;
+    std::multiset<std::string> expected;
+    for (int i = 0; i < 20000; ++i) {
+        std::string key = url();
+        switch (g() % 5) {
+            case 0:
+            case 1:
+                tree.insert(key);
+                expected.insert(key);
+                break;
+            case 2: {
+                tree.remove(key);
+                auto it = expected.find(key);
+                if (it != expected.end()) expected.erase(it);
+                break;
+            }
+            case 3:
+                if (!expected.empty()) {
+                    ASSERT_EQ(tree.removeMax(), *expected.rbegin());
+                    expected.erase(std::prev(expected.end()));
+                }
+                break;
+            default:
+                ASSERT_EQ(tree.count(key), expected.count(key)) << key;
+        }
+    }
+    EXPECT_EQ(tree.elementsCount(), expected.size());
+    EXPECT_EQ(contents(tree), std::vector<std::string>(expected.begin(), expected.end()));
+}
+
+TEST(RadixTreeTest, WorksBehindTheVirtualInterface) {
+    adsc::TreeAdapter<RadixTree<std::string>> adapter;
+    adsc::BinarySortingTree<std::string>& tree = adapter;
+    tree.insert("b");
+    tree.insert("a");
+    EXPECT_EQ(tree.removeMin(), "a");
+    EXPECT_EQ(tree.nodesCount(), 1u);
+}
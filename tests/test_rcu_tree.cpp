@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+#include "RcuTree.hpp"
+
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using adsc::RcuTree;
+
+namespace {
+
+// Key counting its live instances, to observe when retired versions are freed
+struct Tracked {
+    static std::atomic<long> live;
+
+    explicit Tracked(int v) : value(v) { live++; }
+    Tracked(const Tracked& other) : value(other.value) { live++; }
+    Tracked& operator=(const Tracked&) = default;
+    ~Tracked() { live--; }
+
+    bool operator<(const Tracked& other) const { return value < other.value; }
+    bool operator==(const Tracked& other) const { return value == other.value; }
+
+    int value;
+};
+
+std::atomic<long> Tracked::live{0};
+
+} // namespace
+
+TEST(RcuTreeTest, UpdatePublishesOneVersionPerBatch) {
+    RcuTree<int> tree;
+    EXPECT_TRUE(tree.empty());
+    EXPECT_EQ(tree.versionsCount(), 1u);
+
+    tree.update([](RcuTree<int>::Tree& next) {
+        for (int x = 0; x < 100; ++x) next.insert(x % 10);
+    });
+    EXPECT_EQ(tree.versionsCount(), 2u);
+    EXPECT_EQ(tree.nodesCount(), 10u);
+    EXPECT_EQ(tree.elementsCount(), 100u);
+    EXPECT_EQ(tree.count(3), 10u);
+
+    size_t removed = tree.update([](RcuTree<int>::Tree& next) { return next.remove(3, 4); });
+    EXPECT_EQ(removed, 4u);
+    EXPECT_EQ(tree.count(3), 6u);
+    EXPECT_EQ(tree.removeMin(), 0);
+    EXPECT_EQ(tree.max(), 9);
+    EXPECT_EQ(tree.versionsCount(), 4u);
+}
+
+TEST(RcuTreeTest, FailedUpdatePublishesNothing) {
+    RcuTree<int> tree;
+    tree.insert(1);
+    EXPECT_THROW(tree.update([](RcuTree<int>::Tree& next) {
+        next.insert(2);
+        throw std::runtime_error("abort");
+    }), std::runtime_error);
+    EXPECT_FALSE(tree.search(2));
+    EXPECT_EQ(tree.versionsCount(), 2u);
+
+    RcuTree<int> empty;
+    EXPECT_THROW(empty.removeMin(), std::runtime_error);
+    EXPECT_THROW(empty.replace(nullptr), std::invalid_argument);
+}
+
+TEST(RcuTreeTest, ReplaceSwapsTheWholeSet) {
+    RcuTree<int> tree;
+    tree.insert(-1);
+    auto next = std::make_unique<RcuTree<int>::Tree>();
+    for (int x = 0; x < 1000; ++x) next->insert(x);
+    tree.replace(std::move(next));
+
+    EXPECT_FALSE(tree.search(-1));
+    EXPECT_EQ(tree.elementsCount(), 1000u);
+    std::vector<int> contents;
+    tree.forEach([&](int x) { contents.push_back(x); });
+    EXPECT_EQ(contents.size(), 1000u);
+    EXPECT_EQ(contents.front(), 0);
+}
+
+TEST(RcuTreeTest, RetiredVersionsAreFreed) {
+    {
+        RcuTree<Tracked> tree;
+        for (int round = 0; round < 200; ++round) {
+            tree.update([round](RcuTree<Tracked>::Tree& next) {
+                next.insert(Tracked(round % 50));
+            });
+        }
+        // Up to 50 keys per version, only the last few versions may still be alive
+        EXPECT_LT(Tracked::live.load(), 50 * 5);
+    }
+    EXPECT_EQ(Tracked::live.load(), 0);
+}
+
+TEST(RcuTreeTest, ReadersSeeWholeVersions) {
+    // Every version holds exactly the keys [base, base + 100) for some base
+    RcuTree<int> tree;
+    auto build = [](int base) {
+        auto next = std::make_unique<RcuTree<int>::Tree>();
+        for (int x = base; x < base + 100; ++x) next->insert(x);
+        return next;
+    };
+    tree.replace(build(0));
+
+    std::atomic<bool> done{false};
+    std::atomic<long> failures{0};
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 3; ++r) {
+        readers.emplace_back([&] {
+            while (!done) {
+                bool whole = tree.read([](const RcuTree<int>::Tree& version) {
+                    return version.elementsCount() == 100 && version.max() - version.min() == 99 &&
+                           version.search(version.min() + 50);
+                });
+                if (!whole) failures++;
+            }
+        });
+    }
+
+    for (int base = 1; base <= 2000; ++base) {
+        if (base % 2) tree.replace(build(base));
+        else tree.update([base](RcuTree<int>::Tree& next) {
+            next.removeMin();
+            next.insert(base + 99);
+        });
+    }
+    done = true;
+    for (auto& reader : readers) reader.join();
+
+    EXPECT_EQ(failures.load(), 0);
+    EXPECT_EQ(tree.min(), 2000);
+}
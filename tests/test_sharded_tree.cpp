@@ -0,0 +1,161 @@
+#include <gtest/gtest.h>
+#include "ShardedTree.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using adsc::ShardedTree;
+
+namespace {
+
+// Key whose copies throw once copiesLeft runs out, negative never throws
+struct ThrowingCopy {
+    static int copiesLeft;
+
+    explicit ThrowingCopy(int v) : value(v) {}
+    ThrowingCopy(const ThrowingCopy& other) : value(other.value) {
+        if (copiesLeft == 0) throw std::runtime_error("copy failed");
+        if (copiesLeft > 0) --copiesLeft;
+    }
+    ThrowingCopy& operator=(const ThrowingCopy&) = default;
+
+    bool operator<(const ThrowingCopy& other) const { return value < other.value; }
+    bool operator==(const ThrowingCopy& other) const { return value == other.value; }
+
+    int value;
+};
+
+int ThrowingCopy::copiesLeft = -1;
+
+} // namespace
+
+class ShardedTreeTest : public ::testing::Test {
+protected:
+    ShardedTree<int> tree{8};
+};
+
+TEST_F(ShardedTreeTest, PointOperationsAndExtremes) {
+    EXPECT_TRUE(tree.empty());
+    EXPECT_THROW(tree.removeMin(), std::runtime_error);
+
+    for (int x : {50, 20, 80, 20, 10}) tree.insert(x);
+    tree.rebalanceShards();
+    EXPECT_EQ(tree.elementsCount(), 5u);
+    EXPECT_EQ(tree.nodesCount(), 4u);
+    EXPECT_TRUE(tree.search(20));
+    EXPECT_FALSE(tree.search(21));
+
+    tree.remove(20);
+    EXPECT_TRUE(tree.search(20));
+    EXPECT_EQ(tree.removeMin(), 10);
+    EXPECT_EQ(tree.removeMax(), 80);
+    EXPECT_EQ(tree.removeMin(), 20);
+    EXPECT_EQ(tree.removeMin(), 50);
+    EXPECT_TRUE(tree.empty());
+}
+
+TEST_F(ShardedTreeTest, RebalanceSpreadsKeysAndKeepsOrder) {
+    tree.setAutoRebalance(false);
+    for (int x = 0; x < 8000; ++x) tree.insert(x % 2000);
+    EXPECT_EQ(tree.shardSizes()[0], 8000u);
+
+    tree.rebalanceShards();
+    for (size_t size : tree.shardSizes()) {
+        EXPECT_EQ(size, 1000u);
+    }
+
+    std::vector<int> scanned;
+    tree.forEach([&scanned](int x) { scanned.push_back(x); });
+    ASSERT_EQ(scanned.size(), 8000u);
+    EXPECT_TRUE(std::is_sorted(scanned.begin(), scanned.end()));
+}
+
+TEST_F(ShardedTreeTest, SkewTriggersAutomaticRebalance) {
+    // Without splitters every key lands in the first shard, after a rebalance ascending
+    // keys pile into the last one until the splitters move again
+    for (int x = 0; x < 50000; ++x) tree.insert(x);
+
+    std::vector<size_t> sizes = tree.shardSizes();
+    size_t largest = *std::max_element(sizes.begin(), sizes.end());
+    EXPECT_LT(largest, 50000u / 2);
+    EXPECT_EQ(std::accumulate(sizes.begin(), sizes.end(), size_t(0)), 50000u);
+}
+
+TEST_F(ShardedTreeTest, CountersAreReadableDuringRebalances) {
+    const int n = 200000;
+    std::atomic<bool> done{false};
+    std::atomic<long> failures{0};
+    std::thread reader([&] {
+        while (!done) {
+            size_t elements = tree.elementsCount();
+            std::vector<size_t> sizes = tree.shardSizes();
+            if (elements > static_cast<size_t>(n) || tree.nodesCount() > static_cast<size_t>(n)) failures++;
+            if (sizes.size() != tree.shardsCount()) failures++;
+            if (std::accumulate(sizes.begin(), sizes.end(), size_t(0)) > static_cast<size_t>(n)) failures++;
+            tree.empty();
+        }
+    });
+
+    // Ascending keys skew the shards and keep triggering rebalances
+    for (int x = 0; x < n; ++x) tree.insert(x);
+    done = true;
+    reader.join();
+
+    EXPECT_EQ(failures.load(), 0);
+    EXPECT_EQ(tree.elementsCount(), static_cast<size_t>(n));
+}
+
+TEST_F(ShardedTreeTest, ConcurrentWritersKeepEveryElement) {
+    const int threads = 8;
+    const int perThread = 20000;
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([this, t] {
+            std::mt19937 g(t);
+            for (int i = 0; i < perThread; ++i) {
+                int x = static_cast<int>(g() % 100000);
+                tree.insert(x);
+                if (i % 4 == 3) tree.remove(x);
+                tree.search(x);
+            }
+        });
+    }
+    for (auto& worker : workers) worker.join();
+
+    EXPECT_EQ(tree.elementsCount(), static_cast<size_t>(threads * perThread * 3 / 4));
+
+    std::multiset<int> expected;
+    for (int t = 0; t < threads; ++t) {
+        std::mt19937 g(t);
+        for (int i = 0; i < perThread; ++i) {
+            int x = static_cast<int>(g() % 100000);
+            expected.insert(x);
+            if (i % 4 == 3) expected.erase(expected.find(x));
+        }
+    }
+    for (int x : expected) {
+        ASSERT_EQ(tree.removeMin(), x);
+    }
+    EXPECT_TRUE(tree.empty());
+}
+
+TEST(ShardedTreeRebalanceTest, ThrowingRebalanceKeepsEveryElement) {
+    ShardedTree<ThrowingCopy> tree(4);
+    tree.setAutoRebalance(false);
+    for (int x = 0; x < 1000; ++x) tree.insert(ThrowingCopy(x));
+
+    ThrowingCopy::copiesLeft = 500;
+    EXPECT_THROW(tree.rebalanceShards(), std::runtime_error);
+    ThrowingCopy::copiesLeft = -1;
+
+    EXPECT_EQ(tree.elementsCount(), 1000u);
+    int expected = 0;
+    tree.forEach([&](const ThrowingCopy& key) { EXPECT_EQ(key.value, expected++); });
+    EXPECT_EQ(expected, 1000);
+}
@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+#include "SkipList.hpp"
+
+#include <algorithm>
+#include <random>
+#include <set>
+#include <vector>
+
+using adsc::SkipList;
+
+class SkipListTest : public ::testing::Test {
+protected:
+    SkipList<int> list;
+};
+
+TEST_F(SkipListTest, IsEmpty) {
+    EXPECT_TRUE(list.empty());
+    list.insert(10);
+    EXPECT_FALSE(list.empty());
+    EXPECT_THROW(SkipList<int>().removeMin(), std::runtime_error);
+    EXPECT_THROW(SkipList<int>().removeMax(), std::runtime_error);
+}
+
+TEST_F(SkipListTest, SearchAfterInsertAndRemove) {
+    for (int x : {50, 25, 75, 10, 30}) list.insert(x);
+
+    EXPECT_TRUE(list.search(25));
+    EXPECT_FALSE(list.search(26));
+
+    list.remove(25);
+    EXPECT_FALSE(list.search(25));
+    EXPECT_EQ(list.nodesCount(), 4);
+
+    list.remove(1000);
+    EXPECT_EQ(list.elementsCount(), 4);
+}
+
+TEST_F(SkipListTest, MetricsReflectMultiplicity) {
+    for (int x : {50, 50, 50, 20, 20, 80}) list.insert(x);
+    EXPECT_EQ(list.nodesCount(), 3);
+    EXPECT_EQ(list.elementsCount(), 6);
+
+    list.remove(50);
+    list.remove(50);
+    EXPECT_EQ(list.nodesCount(), 3);
+    EXPECT_EQ(list.elementsCount(), 4);
+
+    list.remove(50);
+    EXPECT_EQ(list.nodesCount(), 2);
+    EXPECT_EQ(list.elementsCount(), 3);
+    EXPECT_FALSE(list.search(50));
+}
+
+TEST_F(SkipListTest, SequentialMinMaxRemoval) {
+    for (int x : {50, 25, 75, 10, 30, 10}) list.insert(x);
+
+    EXPECT_EQ(list.removeMin(), 10);
+    EXPECT_EQ(list.removeMin(), 10);
+    EXPECT_EQ(list.removeMax(), 75);
+    EXPECT_EQ(list.nodesCount(), 3);
+
+    EXPECT_EQ(list.removeMax(), 50);
+    EXPECT_EQ(list.removeMin(), 25);
+    EXPECT_EQ(list.removeMin(), 30);
+    EXPECT_TRUE(list.empty());
+    EXPECT_EQ(list.getLevel(), 1);
+}
+
+TEST_F(SkipListTest, CompareWithMultiset) {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> value(0, 500);
+    std::uniform_int_distribution<int> operation(0, 3);
+    std::multiset<int> reference;
+
+    for (int i = 0; i < 20000; ++i) {
+        int x = value(gen);
+        switch (operation(gen)) {
+            case 0:
+            case 1:
+                list.insert(x);
+                reference.insert(x);
+                break;
+            case 2: {
+                list.remove(x);
+                auto it = reference.find(x);
+                if (it != reference.end()) reference.erase(it);
+                break;
+            }
+            default:
+                if (!reference.empty()) {
+                    if (x % 2) {
+                        EXPECT_EQ(list.removeMin(), *reference.begin());
+                        reference.erase(reference.begin());
+                    } else {
+                        EXPECT_EQ(list.removeMax(), *reference.rbegin());
+                        reference.erase(std::prev(reference.end()));
+                    }
+                }
+        }
+        ASSERT_EQ(list.elementsCount(), reference.size());
+        ASSERT_EQ(list.search(x), reference.count(x) > 0);
+    }
+
+    for (int expected : reference) {
+        EXPECT_EQ(list.removeMin(), expected);
+    }
+    EXPECT_TRUE(list.empty());
+}
+
+struct ReverseComparator {
+    bool operator()(int a, int b) const { return a > b; }
+};
+
+TEST(SkipListGenericTest, CustomComparator) {
+    SkipList<int, ReverseComparator> list;
+    for (int x : {1, 3, 2}) list.insert(x);
+
+    EXPECT_EQ(list.removeMin(), 3);
+    EXPECT_EQ(list.removeMax(), 1);
+}
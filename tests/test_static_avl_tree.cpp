@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+#include "StaticAVLTree.hpp"
+#include "AVLTree.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using adsc::StaticAVLTree;
+
+namespace {
+
+constexpr StaticAVLTree<int, 8> kPrimes{7, 2, 13, 5, 3, 11, 17, 19};
+
+// Sorted insertion, the worst case of an unbalanced tree
+template <size_t N>
+constexpr StaticAVLTree<int, N> makeSequence() {
+    StaticAVLTree<int, N> tree;
+    for (int i = 0; i < static_cast<int>(N); ++i) tree.insert(i);
+    return tree;
+}
+
+constexpr auto kSequence = makeSequence<1000>();
+
+} // namespace
+
+// Everything below is checked by the compiler
+static_assert(kPrimes.search(13), "13 is in the table");
+static_assert(!kPrimes.search(4), "4 is not in the table");
+static_assert(*kPrimes.lowerBound(8) == 11, "lowerBound skips to the next key");
+static_assert(*kPrimes.lowerBound(2) == 2, "lowerBound of a present key");
+static_assert(kPrimes.lowerBound(20) == nullptr, "nothing above the maximum");
+static_assert(kPrimes.min() == 2 && kPrimes.max() == 19, "extremes");
+static_assert(kPrimes.nodesCount() == 8 && kPrimes.getHeight() == 4, "balanced");
+static_assert(kSequence.getHeight() == 10, "1000 sorted keys form a tree of height 10");
+
+TEST(StaticAVLTreeTest, RuntimeUse) {
+    StaticAVLTree<int, 16> tree;
+    EXPECT_TRUE(tree.empty());
+    EXPECT_THROW(tree.min(), std::runtime_error);
+    EXPECT_EQ(tree.lowerBound(0), nullptr);
+
+    for (int x : {5, 1, 9, 5, 3}) tree.insert(x);
+    EXPECT_EQ(tree.nodesCount(), 4u);
+    EXPECT_EQ(tree.elementsCount(), 5u);
+    EXPECT_TRUE(tree.search(3));
+    EXPECT_FALSE(tree.search(4));
+    EXPECT_EQ(*tree.lowerBound(4), 5);
+    EXPECT_EQ(tree.max(), 9);
+}
+
+TEST(StaticAVLTreeTest, ThrowsWhenFull) {
+    StaticAVLTree<int, 2> tree{1, 2};
+    // A duplicate only bumps a count
+    tree.insert(2);
+    EXPECT_THROW(tree.insert(3), std::length_error);
+    EXPECT_EQ(tree.nodesCount(), 2u);
+}
+
+TEST(StaticAVLTreeTest, CustomComparator) {
+    constexpr StaticAVLTree<int, 4, std::greater<int>> tree{1, 4, 2, 3};
+    static_assert(tree.min() == 4, "greater orders descending");
+    EXPECT_EQ(*tree.lowerBound(5), 4);
+    EXPECT_EQ(tree.lowerBound(0), nullptr);
+}
+
+TEST(StaticAVLTreeTest, SameShapeAsAVLTree) {
+    // Both trees run the same balancing steps, so equal input gives equal heights
+    std::vector<int> data(5000);
+    std::iota(data.begin(), data.end(), 0);
+    std::mt19937 g(5);
+    std::shuffle(data.begin(), data.end(), g);
+
+    auto table = std::make_unique<StaticAVLTree<int, 5000>>();
+    adsc::AVLTree<int> tree;
+    for (size_t i = 0; i < data.size(); ++i) {
+        table->insert(data[i]);
+        tree.insert(data[i]);
+        if (i % 250 == 0) {
+            ASSERT_EQ(table->getHeight(), tree.getRoot()->getHeight());
+        }
+    }
+    for (int x = -1; x <= 5000; ++x) {
+        ASSERT_EQ(table->search(x), tree.search(x));
+    }
+}